@@ -0,0 +1,213 @@
+#pragma once
+
+/**
+ * A minimal benchmark harness for the signals benchmarks.
+ *
+ * The harness has no dependencies other than the standard library so that
+ * the benchmarks can be built without network access. Every benchmark is
+ * run with an increasing number of iterations until it runs for at least
+ * the minimum time, and the results are written as JSON.
+ *
+ * Command line options:
+ *   --min-time=<seconds>   The minimum time to run each benchmark (default 0.2).
+ *   --filter=<substring>   Only run benchmarks whose name contains the substring.
+ *   --out=<file>           Write the JSON results to a file instead of stdout.
+ * Benchmarks may define additional integer options (see runner::option).
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+    using clock_type = std::chrono::steady_clock;
+    using params_type = std::vector<std::pair<std::string, long long>>;
+
+    struct result
+    {
+        std::string name;
+        params_type params;
+        std::uint64_t iterations;
+        double ns_per_op;
+    };
+
+    // Prevent the compiler from optimizing away a value.
+    template<typename T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    class runner
+    {
+    public:
+        runner(int argc, char* argv[])
+            : m_MinTime(0.2)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                const std::string arg = argv[i];
+                if (arg.compare(0, 11, "--min-time=") == 0)
+                {
+                    m_MinTime = std::atof(arg.c_str() + 11);
+                }
+                else if (arg.compare(0, 9, "--filter=") == 0)
+                {
+                    m_Filter = arg.substr(9);
+                }
+                else if (arg.compare(0, 6, "--out=") == 0)
+                {
+                    m_Out = arg.substr(6);
+                }
+                else
+                {
+                    m_Options.push_back(arg);
+                }
+            }
+        }
+
+        // Get the value of an integer option (--name=value) that is specific to a benchmark.
+        long long option(const std::string& name, long long default_value) const
+        {
+            const auto prefix = "--" + name + "=";
+            for (const auto& arg : m_Options)
+            {
+                if (arg.compare(0, prefix.size(), prefix) == 0)
+                {
+                    return std::atoll(arg.c_str() + prefix.size());
+                }
+            }
+            return default_value;
+        }
+
+        // Run a benchmark.
+        // The function is called with the number of iterations to run and
+        // must perform that many operations.
+        template<typename Func>
+        void run(const std::string& name, const params_type& params, Func&& f)
+        {
+            if (!m_Filter.empty() && name.find(m_Filter) == std::string::npos)
+            {
+                return;
+            }
+
+            std::uint64_t iterations = 1;
+            double seconds = 0.0;
+            for (;;)
+            {
+                const auto start = clock_type::now();
+                f(iterations);
+                seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+
+                if (seconds >= m_MinTime || iterations >= (1ull << 40))
+                {
+                    break;
+                }
+
+                // Estimate the number of iterations needed to reach the minimum time.
+                const double estimate = seconds > 0.0 ? m_MinTime / seconds * 1.2 : 10.0;
+                const double factor = estimate < 2.0 ? 2.0 : (estimate > 10.0 ? 10.0 : estimate);
+                iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) * factor);
+            }
+
+            result r{ name, params, iterations, seconds * 1e9 / static_cast<double>(iterations) };
+            std::cerr << r.name;
+            for (const auto& p : r.params)
+            {
+                std::cerr << " " << p.first << "=" << p.second;
+            }
+            std::cerr << ": " << r.ns_per_op << " ns/op" << std::endl;
+
+            m_Results.push_back(std::move(r));
+        }
+
+        // Write the results as JSON.
+        void write_json(std::ostream& os) const
+        {
+            char date[32] = {};
+            const std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            os << "{\n";
+            os << "  \"context\": {\n";
+            os << "    \"date\": \"" << date << "\",\n";
+            os << "    \"compiler\": \"" << compiler() << "\",\n";
+            os << "    \"cplusplus\": " << __cplusplus << ",\n";
+#if defined(NDEBUG)
+            os << "    \"assertions\": false,\n";
+#else
+            os << "    \"assertions\": true,\n";
+#endif
+            os << "    \"min_time\": " << m_MinTime << "\n";
+            os << "  },\n";
+            os << "  \"benchmarks\": [";
+            for (std::size_t i = 0; i < m_Results.size(); ++i)
+            {
+                const auto& r = m_Results[i];
+                os << (i > 0 ? ",\n" : "\n");
+                os << "    { \"name\": \"" << r.name << "\", \"params\": {";
+                for (std::size_t j = 0; j < r.params.size(); ++j)
+                {
+                    os << (j > 0 ? ", " : " ") << "\"" << r.params[j].first << "\": " << r.params[j].second;
+                }
+                os << (r.params.empty() ? "}" : " }");
+                os << ", \"iterations\": " << r.iterations;
+                os << ", \"ns_per_op\": " << r.ns_per_op;
+                os << ", \"ops_per_second\": " << 1e9 / r.ns_per_op << " }";
+            }
+            os << "\n  ]\n";
+            os << "}\n";
+        }
+
+        // Write the results to the output file or stdout.
+        int finish() const
+        {
+            if (m_Out.empty())
+            {
+                write_json(std::cout);
+                return 0;
+            }
+
+            std::ofstream file(m_Out);
+            if (!file)
+            {
+                std::cerr << "Failed to open " << m_Out << std::endl;
+                return 1;
+            }
+            write_json(file);
+            return 0;
+        }
+
+    private:
+        static std::string compiler()
+        {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+            return "unknown";
+#endif
+        }
+
+        double m_MinTime;
+        std::string m_Filter;
+        std::string m_Out;
+        std::vector<std::string> m_Options;
+        std::vector<result> m_Results;
+    };
+}
@@ -0,0 +1,216 @@
+/**
+ * Measures the compile time and the object size of a translation unit that
+ * instantiates many distinct signal signatures.
+ *
+ * The generated translation unit declares <n> signatures (alternating between
+ * void and non-void return types). Each signature is connected to a free
+ * function, a lambda, a member function, and a tracked member function, and
+ * is then invoked. The translation unit is compiled once per mode:
+ *
+ *   cpp11         -std=c++11
+ *   cpp17_compat  -std=c++17 -DSIG_CPP17=0 (the C++11 code paths)
+ *   cpp17         -std=c++17 (std::invoke, if constexpr, and the standard traits)
+ *
+ * Usage: compile_benchmark [--signatures=<n>] [--repetitions=<n>] [--opt=<flag>] [--out=<file>]
+ * The defaults are 20 signatures, 1 repetition (the fastest one is reported), and -O2.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef SIG_BENCH_CXX_COMPILER
+#error "SIG_BENCH_CXX_COMPILER must be defined"
+#endif
+
+#ifndef SIG_BENCH_INCLUDE_DIR
+#error "SIG_BENCH_INCLUDE_DIR must be defined"
+#endif
+
+namespace
+{
+    struct mode
+    {
+        const char* name;
+        const char* flags;
+    };
+
+    const mode modes[] = {
+        { "cpp11", "-std=c++11" },
+        { "cpp17_compat", "-std=c++17 -DSIG_CPP17=0" },
+        { "cpp17", "-std=c++17" },
+    };
+
+    struct result
+    {
+        std::string name;
+        unsigned signatures;
+        double seconds;
+        long long object_size;
+    };
+
+    std::string generate(unsigned signatures)
+    {
+        std::ostringstream os;
+        os << "#include <signals.hpp>\n#include <memory>\n\n";
+
+        for (unsigned i = 0; i < signatures; ++i)
+        {
+            const bool is_void = i % 2 != 0;
+            const std::string r = is_void ? "void" : "int";
+            const std::string body = is_void ? "{ a.value += " + std::to_string(i) + "; }" : "{ return a.value + " + std::to_string(i) + "; }";
+            const std::string arg = is_void ? "arg" + std::to_string(i) + "&" : "arg" + std::to_string(i);
+            const auto n = std::to_string(i);
+
+            os << "struct arg" << n << " { int value; };\n"
+                << "struct receiver" << n << " { " << r << " on(" << arg << " a) " << body << " };\n"
+                << r << " func" << n << "(" << arg << " a) " << body << "\n"
+                << "int emit" << n << "()\n{\n"
+                << "    sig::signal<" << r << "(" << arg << ")> s;\n"
+                << "    receiver" << n << " obj;\n"
+                << "    auto tracked = std::make_shared<receiver" << n << ">();\n"
+                << "    s.connect(&func" << n << ");\n"
+                << "    s.connect([](" << arg << " a) " << body << ");\n"
+                << "    s.connect(&receiver" << n << "::on, &obj);\n"
+                << "    s.connect(&receiver" << n << "::on, tracked);\n";
+            if (is_void)
+            {
+                os << "    arg" << n << " a{ 0 };\n    s(a);\n    return a.value;\n}\n\n";
+            }
+            else
+            {
+                os << "    return *s(arg" << n << "{ 0 });\n}\n\n";
+            }
+        }
+
+        os << "int emit_all()\n{\n    return 0";
+        for (unsigned i = 0; i < signatures; ++i)
+        {
+            os << " + emit" << i << "()";
+        }
+        os << ";\n}\n";
+        return os.str();
+    }
+
+    long long file_size(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        return file ? static_cast<long long>(file.tellg()) : -1;
+    }
+
+    // Compile the source and return the time it took in seconds, or a negative value on error.
+    double compile(const std::string& source, const std::string& object, const mode& m, const std::string& opt)
+    {
+        const std::string command = std::string("\"") + SIG_BENCH_CXX_COMPILER + "\" " + m.flags + " " + opt
+            + " -I\"" + SIG_BENCH_INCLUDE_DIR + "\" -c \"" + source + "\" -o \"" + object + "\"";
+
+        const auto start = std::chrono::steady_clock::now();
+        const int status = std::system(command.c_str());
+        const auto stop = std::chrono::steady_clock::now();
+
+        if (status != 0)
+        {
+            std::cerr << "Error: " << command << " failed" << std::endl;
+            return -1.0;
+        }
+        return std::chrono::duration<double>(stop - start).count();
+    }
+
+    void write_json(std::ostream& os, const std::vector<result>& results)
+    {
+        os << "{\n  \"compiler\": \"" << SIG_BENCH_CXX_COMPILER << "\",\n  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& r = results[i];
+            os << "    { \"name\": \"" << r.name << "\", \"params\": { \"signatures\": " << r.signatures
+                << " }, \"seconds\": " << r.seconds << ", \"object_size\": " << r.object_size << " }"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        os << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned signatures = 20;
+    unsigned repetitions = 1;
+    std::string opt = "-O2";
+    std::string out;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        const auto name = arg.substr(0, eq);
+        const auto value = eq == std::string::npos ? std::string() : arg.substr(eq + 1);
+
+        if (name == "--signatures")
+            signatures = static_cast<unsigned>(std::atoi(value.c_str()));
+        else if (name == "--repetitions")
+            repetitions = static_cast<unsigned>(std::atoi(value.c_str()));
+        else if (name == "--opt")
+            opt = value;
+        else if (name == "--out")
+            out = value;
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    if (signatures == 0 || repetitions == 0)
+    {
+        std::cerr << "--signatures and --repetitions must be positive" << std::endl;
+        return 2;
+    }
+
+    const std::string source = "compile_benchmark_generated.cpp";
+    const std::string object = "compile_benchmark_generated.o";
+    {
+        std::ofstream file(source);
+        file << generate(signatures);
+    }
+
+    std::vector<result> results;
+    for (const auto& m : modes)
+    {
+        double best = 0.0;
+        for (unsigned i = 0; i < repetitions; ++i)
+        {
+            const double seconds = compile(source, object, m, opt);
+            if (seconds < 0.0)
+            {
+                return 1;
+            }
+            if (i == 0 || seconds < best)
+            {
+                best = seconds;
+            }
+        }
+
+        results.push_back({ m.name, signatures, best, file_size(object) });
+        std::cerr << std::setw(16) << std::left << m.name << std::right << std::fixed << std::setprecision(3)
+            << std::setw(10) << best << " s" << std::setw(12) << results.back().object_size << " bytes" << std::endl;
+    }
+
+    std::remove(source.c_str());
+    std::remove(object.c_str());
+
+    if (out.empty())
+    {
+        write_json(std::cout, results);
+    }
+    else
+    {
+        std::ofstream file(out);
+        write_json(file, results);
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * Compares broadcasting to a very large number of slots of the same type
+ * using a sig::fanout_signal with a sig::signal.
+ *
+ * Every slot adds the argument to its own counter, so invoking the slots is
+ * bound by the memory bandwidth. A plain loop over an array of the slots is
+ * measured as the baseline. The results are reported per slot invocation.
+ *
+ * Usage: fanout_benchmark [--slots=<n>] [benchmark options]
+ * The default is 1,000,000 slots.
+ */
+
+#include "benchmark.hpp"
+#include "signals.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    struct counter
+    {
+        void operator()(std::uint64_t i) noexcept
+        {
+            value += i;
+        }
+
+        std::uint64_t value = 0;
+    };
+
+    // Invoke the signal until at least the given number of slots were invoked.
+    template<typename Signal>
+    void emit(Signal& s, std::uint64_t slots, std::uint64_t iterations)
+    {
+        for (std::uint64_t i = 0; i < iterations; i += slots)
+        {
+            s(1);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bench::runner runner(argc, argv);
+
+    const auto num_slots = static_cast<std::uint64_t>(runner.option("slots", 1000000));
+    const bench::params_type params = { { "slots", static_cast<long long>(num_slots) } };
+
+    std::cerr << "Slot size: " << sizeof(counter) << " bytes" << std::endl;
+
+    {
+        std::vector<counter> counters(num_slots);
+        runner.run("array_loop", params, [&](std::uint64_t iterations)
+        {
+            for (std::uint64_t i = 0; i < iterations; i += num_slots)
+            {
+                for (auto& c : counters)
+                {
+                    c(1);
+                }
+                bench::do_not_optimize(counters.front());
+            }
+        });
+    }
+
+    {
+        sig::fanout_signal<void(std::uint64_t), counter> s;
+        for (std::uint64_t i = 0; i < num_slots; ++i)
+        {
+            s.emplace();
+        }
+
+        runner.run("fanout_signal_emit", params, [&](std::uint64_t iterations)
+        {
+            emit(s, num_slots, iterations);
+        });
+    }
+
+    {
+        sig::signal<void(std::uint64_t)> s;
+        for (std::uint64_t i = 0; i < num_slots; ++i)
+        {
+            s.connect(counter());
+        }
+
+        runner.run("signal_emit", params, [&](std::uint64_t iterations)
+        {
+            emit(s, num_slots, iterations);
+        });
+    }
+
+    return runner.finish();
+}
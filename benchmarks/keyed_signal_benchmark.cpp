@@ -0,0 +1,85 @@
+/**
+ * Compares dispatching to the listeners of a single key using a
+ * sig::keyed_signal with a sig::signal where every listener filters
+ * on the key itself.
+ *
+ * Usage: keyed_signal_benchmark [--keys=<n>] [--listeners=<n>] [benchmark options]
+ * The defaults are 100,000 keys and 1,000,000 listeners.
+ */
+
+#include "benchmark.hpp"
+#include "signals.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+struct Tick
+{
+    std::uint32_t instrument;
+    double price;
+};
+
+int main(int argc, char* argv[])
+{
+    bench::runner runner(argc, argv);
+
+    const auto num_keys = static_cast<std::uint32_t>(runner.option("keys", 100000));
+    const auto num_listeners = static_cast<std::uint32_t>(runner.option("listeners", 1000000));
+    const bench::params_type params = { { "keys", num_keys }, { "listeners", num_listeners } };
+
+    // Random keys to emit.
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::uint32_t> random_key(0, num_keys - 1);
+    std::vector<std::uint32_t> keys(1 << 16);
+    for (auto& key : keys)
+    {
+        key = random_key(rng);
+    }
+    const auto mask = keys.size() - 1;
+
+    std::uint64_t received = 0;
+
+    {
+        sig::keyed_signal<std::uint32_t, void(const Tick&)> s;
+        for (std::uint32_t i = 0; i < num_listeners; ++i)
+        {
+            s.connect(i % num_keys, [&received](const Tick&) { ++received; });
+        }
+
+        runner.run("keyed_signal_emit", params, [&](std::uint64_t iterations)
+        {
+            for (std::uint64_t i = 0; i < iterations; ++i)
+            {
+                const auto key = keys[i & mask];
+                s(key, Tick{ key, 1.0 });
+            }
+        });
+    }
+
+    {
+        sig::signal<void(const Tick&)> s;
+        for (std::uint32_t i = 0; i < num_listeners; ++i)
+        {
+            const auto key = i % num_keys;
+            s.connect([&received, key](const Tick& tick)
+            {
+                if (tick.instrument == key)
+                    ++received;
+            });
+        }
+
+        runner.run("filtered_signal_emit", params, [&](std::uint64_t iterations)
+        {
+            for (std::uint64_t i = 0; i < iterations; ++i)
+            {
+                const auto key = keys[i & mask];
+                s(Tick{ key, 1.0 });
+            }
+        });
+    }
+
+    bench::do_not_optimize(received);
+
+    return runner.finish();
+}
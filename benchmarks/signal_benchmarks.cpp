@@ -0,0 +1,444 @@
+/**
+ * Microbenchmarks for the sig::signal class.
+ *
+ * Usage: signal_benchmarks [--min-time=<seconds>] [--filter=<substring>] [--out=<file>]
+ * The results are written as JSON (see benchmark.hpp).
+ */
+
+#include "benchmark.hpp"
+#include "signals.hpp"
+
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    thread_local long long sink = 0;
+
+    void add(int i)
+    {
+        sink += i;
+    }
+
+    void subtract(int i)
+    {
+        sink -= i;
+    }
+
+    struct Receiver
+    {
+        void add(int i)
+        {
+            value += i;
+        }
+
+        long long value = 0;
+    };
+
+    using signal = sig::signal<void(int)>;
+
+    // The cost of invoking a signal with the given number of slots.
+    void emit(bench::runner& runner)
+    {
+        for (int slots : { 0, 1, 4, 64, 4096 })
+        {
+            signal s;
+            for (int i = 0; i < slots; ++i)
+            {
+                s.connect(&add);
+            }
+
+            runner.run("emit", { { "slots", slots } }, [&s](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    s(1);
+                }
+                bench::do_not_optimize(sink);
+            });
+        }
+
+        // The same slots stored in chunks.
+        for (int slots : { 64, 4096 })
+        {
+            sig::signal<void(int), sig::optional_last_value<void>, sig::chunked_slots<>> s;
+            for (int i = 0; i < slots; ++i)
+            {
+                s.connect(&add);
+            }
+
+            runner.run("emit_chunked", { { "slots", slots } }, [&s](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    s(1);
+                }
+                bench::do_not_optimize(sink);
+            });
+        }
+    }
+
+    // The cost of invoking a signal that forwards to other signals.
+    // Each signal has four slots. Up to SIG_INLINE_FORWARDS targets are
+    // collected without allocating memory.
+    void emit_forwarded(bench::runner& runner)
+    {
+        for (int targets : { 1, 4, 16 })
+        {
+            signal source;
+            std::vector<signal> forwards(targets);
+            for (int i = 0; i < 4; ++i)
+            {
+                source.connect(&add);
+                for (auto& target : forwards)
+                {
+                    target.connect(&add);
+                }
+            }
+            for (auto& target : forwards)
+            {
+                source.forward_to(target);
+            }
+
+            runner.run("emit_forwarded", { { "targets", targets } }, [&source](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    source(1);
+                }
+                bench::do_not_optimize(sink);
+            });
+        }
+    }
+
+    // The cost of connecting a slot and disconnecting it through its connection.
+    void connect_disconnect(bench::runner& runner)
+    {
+        for (int slots : { 0, 64, 4096 })
+        {
+            signal s;
+            for (int i = 0; i < slots; ++i)
+            {
+                s.connect(&add);
+            }
+
+            runner.run("connect_disconnect", { { "slots", slots } }, [&s](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto c = s.connect(&subtract);
+                    c.disconnect();
+                }
+            });
+        }
+
+        // Disconnect the slots of an ungrouped signal one after another and
+        // connect them again at the back.
+        for (int slots : { 64, 4096 })
+        {
+            signal s;
+            std::vector<sig::connection> connections;
+            for (int i = 0; i < slots; ++i)
+            {
+                connections.push_back(s.connect(&add));
+            }
+
+            runner.run("disconnect_reconnect", { { "slots", slots } }, [&s, &connections](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto& c = connections[i % connections.size()];
+                    c.disconnect();
+                    c = s.connect(&add);
+                }
+            });
+        }
+    }
+
+    // The cost of connecting a slot to the middle one of 40 groups (or at
+    // the front of the ungrouped slots) and disconnecting it through its
+    // connection. The slots are spread evenly over the groups.
+    void connect_disconnect_grouped(bench::runner& runner)
+    {
+        const int groups = 40;
+        for (int slots : { 64, 4096 })
+        {
+            signal s;
+            for (int i = 0; i < slots; ++i)
+            {
+                s.connect(i % groups, &add);
+            }
+
+            runner.run("connect_disconnect_grouped", { { "slots", slots }, { "groups", groups } }, [&s](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto c = s.connect(groups / 2, &subtract);
+                    c.disconnect();
+                }
+            });
+
+            runner.run("connect_disconnect_front", { { "slots", slots }, { "groups", groups } }, [&s](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto c = s.connect(&subtract, sig::at_front);
+                    c.disconnect();
+                }
+            });
+        }
+    }
+
+    // The cost of connecting slots to an empty signal.
+    void connect(bench::runner& runner)
+    {
+        const int slots = 1024;
+        runner.run("connect", { { "slots", slots } }, [slots](std::uint64_t iterations)
+        {
+            for (std::uint64_t i = 0; i < iterations; i += slots)
+            {
+                signal s;
+                for (int j = 0; j < slots; ++j)
+                {
+                    s.connect(&add);
+                }
+            }
+        });
+    }
+
+    // The cost of disconnecting a slot by comparing it to the connected slots.
+    void disconnect_by_value(bench::runner& runner)
+    {
+        for (int slots : { 0, 64, 4096 })
+        {
+            signal s;
+            for (int i = 0; i < slots; ++i)
+            {
+                s.connect(&add);
+            }
+
+            runner.run("disconnect_by_value", { { "slots", slots } }, [&s](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    s.connect(&subtract);
+                    s.disconnect(&subtract);
+                }
+            });
+        }
+    }
+
+    // The cost of invoking member function slots with raw pointers (untracked)
+    // and shared pointers (tracked).
+    void tracked(bench::runner& runner)
+    {
+        const int slots = 64;
+        std::vector<std::shared_ptr<Receiver>> receivers;
+        for (int i = 0; i < slots; ++i)
+        {
+            receivers.push_back(std::make_shared<Receiver>());
+        }
+
+        signal untracked;
+        signal tracked;
+        for (auto& r : receivers)
+        {
+            untracked.connect(&Receiver::add, r.get());
+            tracked.connect(&Receiver::add, r);
+        }
+
+        runner.run("emit_untracked", { { "slots", slots } }, [&untracked](std::uint64_t iterations)
+        {
+            for (std::uint64_t i = 0; i < iterations; ++i)
+            {
+                untracked(1);
+            }
+        });
+
+        runner.run("emit_tracked", { { "slots", slots } }, [&tracked](std::uint64_t iterations)
+        {
+            for (std::uint64_t i = 0; i < iterations; ++i)
+            {
+                tracked(1);
+            }
+        });
+    }
+
+    // The cost of connecting and disconnecting a slot while the signal is
+    // invoked, which copies the shared slot list. The slot list is stored in
+    // a single vector (the default) or in chunks (sig::chunked_slots).
+    template<typename Signal>
+    void connect_during_emit(bench::runner& runner, const char* name)
+    {
+        for (int slots : { 4096, 65536 })
+        {
+            Signal s;
+            for (int i = 0; i < slots; ++i)
+            {
+                s.connect(&add);
+            }
+
+            s.connect([&s](int)
+            {
+                auto c = s.connect(&subtract);
+                c.disconnect();
+            });
+
+            runner.run(name, { { "slots", slots } }, [&s](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    s(1);
+                }
+                bench::do_not_optimize(sink);
+            });
+        }
+    }
+
+    // The cost of invoking slots that are bound at compile time compared
+    // with slots that store a function pointer.
+    void bound(bench::runner& runner)
+    {
+        const int slots = 64;
+        Receiver receiver;
+
+        signal function;
+        signal bound_function;
+        signal member;
+        signal bound_member;
+        for (int i = 0; i < slots; ++i)
+        {
+            function.connect(&add);
+            bound_function.connect<decltype(&add), &add>();
+            member.connect(&Receiver::add, &receiver);
+            bound_member.connect<decltype(&Receiver::add), &Receiver::add>(&receiver);
+        }
+
+        const std::pair<const char*, signal*> signals[] = {
+            { "emit_function", &function },
+            { "emit_bound_function", &bound_function },
+            { "emit_member", &member },
+            { "emit_bound_member", &bound_member },
+        };
+
+        for (const auto& entry : signals)
+        {
+            auto& s = *entry.second;
+            runner.run(entry.first, { { "slots", slots } }, [&s](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    s(1);
+                }
+            });
+        }
+        bench::do_not_optimize(receiver.value);
+    }
+
+    // A function object type per N.
+    template<int N>
+    struct add_n
+    {
+        void operator()(int i) const
+        {
+            sink += i * N;
+        }
+    };
+
+    // Functions that connect a slot of one of the types.
+    template<typename Signal, int... N>
+    std::vector<void (*)(Signal&)> connectors()
+    {
+        return { [](Signal& s) { s.connect(add_n<N>()); }... };
+    }
+
+    // The cost of invoking 1000 slots of 20 different types that are connected
+    // in a random order, with and without grouping the slots by type.
+    template<typename Signal>
+    void emit_types(bench::runner& runner, const char* name)
+    {
+        const int slots = 1000;
+        const auto connect = connectors<Signal, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19>();
+        const auto types = static_cast<int>(connect.size());
+
+        Signal s;
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> next_type(0, types - 1);
+        for (int i = 0; i < slots; ++i)
+        {
+            connect[next_type(random)](s);
+        }
+
+        runner.run(name, { { "slots", slots }, { "types", types } }, [&s](std::uint64_t iterations)
+        {
+            for (std::uint64_t i = 0; i < iterations; ++i)
+            {
+                s(1);
+            }
+            bench::do_not_optimize(sink);
+        });
+    }
+
+    // The cost of invoking a single signal from multiple threads at the same time.
+    // Reports the wall time per emission over all threads.
+    void threaded_emit(bench::runner& runner)
+    {
+        for (int slots : { 4, 64 })
+        {
+            signal s;
+            for (int i = 0; i < slots; ++i)
+            {
+                s.connect(&add);
+            }
+
+            for (int threads : { 1, 2, 4, 8, 16, 32, 64 })
+            {
+                runner.run("threaded_emit", { { "slots", slots }, { "threads", threads } }, [&s, threads](std::uint64_t iterations)
+                {
+                    const auto per_thread = (iterations + threads - 1) / threads;
+                    std::vector<std::thread> workers;
+                    for (int t = 0; t < threads; ++t)
+                    {
+                        workers.emplace_back([&s, per_thread]()
+                        {
+                            for (std::uint64_t i = 0; i < per_thread; ++i)
+                            {
+                                s(1);
+                            }
+                            bench::do_not_optimize(sink);
+                        });
+                    }
+
+                    for (auto& w : workers)
+                    {
+                        w.join();
+                    }
+                });
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bench::runner runner(argc, argv);
+
+    emit(runner);
+    emit_forwarded(runner);
+    connect(runner);
+    connect_disconnect(runner);
+    connect_disconnect_grouped(runner);
+    disconnect_by_value(runner);
+    connect_during_emit<signal>(runner, "connect_during_emit");
+    connect_during_emit<sig::signal<void(int), sig::optional_last_value<void>, sig::chunked_slots<>>>(runner, "connect_during_emit_chunked");
+    tracked(runner);
+    bound(runner);
+    emit_types<signal>(runner, "emit_interleaved_types");
+    emit_types<sig::signal<void(int), sig::optional_last_value<void>, sig::type_grouped_slots<>>>(runner, "emit_grouped_types");
+    threaded_emit(runner);
+
+    return runner.finish();
+}
@@ -0,0 +1,33 @@
+#include "signals.hpp"
+#include <iostream>
+#include <vector>
+
+float product(float x, float y) { return x * y; }
+float sum(float x, float y) { return x + y; }
+
+int main()
+{
+    // Define a signal that takes two floats and returns the sum of the connected slots.
+    using signal = sig::signal<float(float, float), sig::sum_value<float>>;
+    signal s;
+
+    s.connect(&product);
+    s.connect(&sum);
+
+    // A batch of argument sets.
+    std::vector<signal::args_type> batch = {
+        std::make_tuple(1.0f, 2.0f),
+        std::make_tuple(3.0f, 4.0f),
+        std::make_tuple(5.0f, 6.0f),
+    };
+
+    // Invoke the signal for every argument set in the batch.
+    // The product slot is invoked for all argument sets
+    // before the sum slot is invoked.
+    for (auto result : s.emit_batch(batch))
+    {
+        std::cout << *result << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "signals.hpp"
+#include <iostream>
+#include <memory>
+
+class Counter
+{
+public:
+    void add(int i)
+    {
+        m_Count += i;
+    }
+
+    int count() const
+    {
+        return m_Count;
+    }
+
+private:
+    int m_Count = 0;
+};
+
+void print(int i)
+{
+    std::cout << "Value: " << i << std::endl;
+}
+
+int main()
+{
+    using signal = sig::signal<void(int)>;
+    signal s;
+
+    Counter counter;
+    auto tracked = std::make_shared<Counter>();
+
+    // Bind the functions at compile time. In C++17, the functions can be
+    // passed without their type: s.connect<&print>() and s.connect<&Counter::add>(&counter).
+    s.connect<decltype(&print), &print>();
+    s.connect<decltype(&Counter::add), &Counter::add>(&counter);
+    s.connect<decltype(&Counter::add), &Counter::add>(tracked);
+
+    s(1);
+    s(2);
+
+    // Disconnect the slot that is bound to Counter::add on counter.
+    s.disconnect<decltype(&Counter::add), &Counter::add>(&counter);
+
+    s(3);
+
+    std::cout << "Counter: " << counter.count() << std::endl;
+    std::cout << "Tracked: " << tracked->count() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "signals.hpp"
+#include <iostream>
+#include <vector>
+
+struct Entity
+{
+    void update(float dt) noexcept
+    {
+        position += velocity * dt;
+    }
+
+    float position = 0.0f;
+    float velocity = 1.0f;
+};
+
+int main()
+{
+    // Store the slots in chunks of 256 slots.
+    using signal = sig::signal<void(float), sig::optional_last_value<void>, sig::chunked_slots<256>>;
+    signal update;
+
+    std::vector<Entity> entities(10000);
+    for (auto& e : entities)
+    {
+        update.connect(&Entity::update, &e);
+    }
+
+    // Spawning an entity while the signal is invoked only copies the last
+    // chunk of slots instead of all 10000 slots.
+    Entity spawned;
+    bool spawn = true;
+    update.connect([&](float)
+    {
+        if (spawn)
+        {
+            update.connect(&Entity::update, &spawned);
+            spawn = false;
+        }
+    });
+
+    update(0.5f);
+    update(0.5f);
+
+    std::cout << "Slots: " << update.num_slots() << std::endl;
+    std::cout << "Position: " << entities.front().position << std::endl;
+    std::cout << "Spawned position: " << spawned.position << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "signals.hpp"
+#include <iostream>
+#include <vector>
+
+// A combiner that reuses its result vector on every invocation
+// and counts the number of times the signal was invoked.
+class collect_values
+{
+public:
+    using result_type = const std::vector<float>&;
+
+    explicit collect_values(std::size_t capacity)
+        : m_Invocations(0)
+    {
+        m_Values.reserve(capacity);
+    }
+
+    template<typename InputIterator>
+    result_type operator()(InputIterator first, InputIterator last)
+    {
+        ++m_Invocations;
+        m_Values.clear();
+        while (first != last)
+        {
+            auto value = *first++;
+            if (value)
+                m_Values.push_back(*value);
+        }
+        return m_Values;
+    }
+
+    int invocations() const
+    {
+        return m_Invocations;
+    }
+
+private:
+    std::vector<float> m_Values;
+    int m_Invocations;
+};
+
+float product(float x, float y) { return x * y; }
+float sum(float x, float y) { return x + y; }
+
+int main()
+{
+    // The signal keeps the combiner instance and passes it by reference
+    // every time the signal is invoked.
+    using signal = sig::signal<float(float, float), collect_values>;
+    signal s(collect_values(16));
+
+    s.connect(&product);
+    s.connect(&sum);
+
+    for (float x = 1.0f; x <= 3.0f; x += 1.0f)
+    {
+        std::cout << "Values: ";
+        for (auto f : s(x, 2.0f))
+        {
+            std::cout << f << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "Invocations: " << s.combiner().invocations() << std::endl;
+
+    return 0;
+}
@@ -28,11 +28,10 @@ int main()
     std::cout << *s(5.0f, 3.0f) << std::endl;
 
     // Disconnect the first slot.
-    // For efficency, sum becomes the first slot.
+    // The order of the remaining slots is preserved.
     s.disconnect(&product);
 
-    // This actually prints 1.6667 since 
-    // quotient becomes the last slot in the signal.
+    // Still prints 8 since sum is still the last slot in the signal.
     std::cout << *s(5.0f, 3.0f) << std::endl;
 
     s.disconnect(&quotient);
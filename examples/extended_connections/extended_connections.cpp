@@ -0,0 +1,28 @@
+#include "signals.hpp"
+#include <iostream>
+
+int main()
+{
+    // Define a signal that takes no arguments and returns void.
+    using signal = sig::signal<void()>;
+    signal s;
+
+    // Connect an extended slot.
+    // The slot receives a handle to its own connection
+    // and disconnects itself the first time it is invoked.
+    s.connect_extended([](sig::connection_handle& c)
+    {
+        std::cout << "Hello, World!" << std::endl;
+        c.disconnect();
+    });
+
+    // Invoke the signal.
+    // This should print "Hello, World!" to the console.
+    s();
+
+    // Invoke the signal again.
+    // Nothing is printed to the console.
+    s();
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "signals.hpp"
+#include <iostream>
+#include <vector>
+
+struct Particle
+{
+    float position;
+    float velocity;
+};
+
+// The slot type of the signal. The slots are stored by value.
+struct UpdateParticle
+{
+    void operator()(float dt) const noexcept
+    {
+        particle->position += particle->velocity * dt;
+    }
+
+    Particle* particle;
+};
+
+int main()
+{
+    using signal = sig::fanout_signal<void(float), UpdateParticle>;
+    signal update;
+
+    std::vector<Particle> particles(100000, Particle{ 0.0f, 1.0f });
+    std::vector<signal::slot_id> ids;
+    for (auto& p : particles)
+    {
+        ids.push_back(update.emplace(UpdateParticle{ &p }));
+    }
+
+    // Disconnecting a slot moves the last slot into its place.
+    update.disconnect(ids.front());
+
+    update(0.5f);
+    update(0.5f);
+
+    std::cout << "Slots: " << update.num_slots() << std::endl;
+    std::cout << "First particle: " << particles.front().position << std::endl;
+    std::cout << "Last particle: " << particles.back().position << std::endl;
+
+    return 0;
+}
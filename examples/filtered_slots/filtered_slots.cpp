@@ -0,0 +1,25 @@
+#include "signals.hpp"
+#include <iostream>
+
+void on_key(int key)
+{
+    std::cout << "Key pressed: " << key << std::endl;
+}
+
+int main()
+{
+    // Define a signal that takes a key code and returns void.
+    using signal = sig::signal<void(int)>;
+    signal s;
+
+    // Connect a slot that is only invoked for the escape key (27).
+    s.connect(sig::filter([](int key) { return key == 27; }), &on_key);
+
+    // Invoke the signal.
+    // Only the escape key is printed to the console.
+    s(13);
+    s(27);
+    s(32);
+
+    return 0;
+}
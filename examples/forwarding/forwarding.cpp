@@ -0,0 +1,33 @@
+#include "signals.hpp"
+#include <iostream>
+
+int main()
+{
+    // Define a signal that takes no arguments and returns void.
+    using signal = sig::signal<void()>;
+    signal application, window, button;
+
+    application.connect([]() { std::cout << "Application" << std::endl; });
+    window.connect([]() { std::cout << "Window" << std::endl; });
+    button.connect([]() { std::cout << "Button" << std::endl; });
+
+    // Invoking the application signal also invokes the slots
+    // of the window signal and the button signal.
+    application.forward_to(window);
+    window.forward_to(button);
+
+    application();
+
+    // Forwarding the button signal to the application signal
+    // would create a forwarding cycle.
+    try
+    {
+        button.forward_to(application);
+    }
+    catch (const sig::forwarding_cycle_exception&)
+    {
+        std::cout << "Forwarding cycle detected." << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+#include "signals.hpp"
+#include <iostream>
+#include <string>
+
+int main()
+{
+    // Define a signal that dispatches a price to the slots of an instrument.
+    using signal = sig::keyed_signal<std::string, void(double)>;
+    signal s;
+
+    // Connect slots to a single instrument.
+    s.connect("AAPL", [](double price) { std::cout << "AAPL: " << price << std::endl; });
+    s.connect("MSFT", [](double price) { std::cout << "MSFT: " << price << std::endl; });
+
+    // Connect a slot that is invoked for every instrument.
+    s.connect_any([](double price) { std::cout << "Any: " << price << std::endl; });
+
+    // Only the AAPL slot and the wildcard slot are invoked.
+    s("AAPL", 170.5);
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include "signals.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+
+class Logger
+{
+public:
+    explicit Logger(std::string prefix)
+        : m_Prefix(std::move(prefix))
+    {}
+
+    void log(const std::string& message) const
+    {
+        std::cout << m_Prefix << message << std::endl;
+    }
+
+private:
+    std::string m_Prefix;
+};
+
+int main()
+{
+    using signal = sig::signal<void(const std::string&)>;
+    signal s;
+
+    // The function object owns the logger and can only be moved.
+    std::unique_ptr<Logger> logger(new Logger("[log] "));
+    auto log = [logger = std::move(logger)](const std::string& message) { logger->log(message); };
+
+    // Move the function object into the signal. The slot and the function
+    // object are stored in a single allocation.
+    s.connect(std::move(log));
+
+    s("Hello, World!");
+
+    return 0;
+}
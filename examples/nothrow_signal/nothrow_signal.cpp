@@ -0,0 +1,48 @@
+#include "signals.hpp"
+#include <iostream>
+
+class Counter
+{
+public:
+    void add(int i) noexcept
+    {
+        m_Total += i;
+    }
+
+    int total() const noexcept
+    {
+        return m_Total;
+    }
+
+private:
+    int m_Total = 0;
+};
+
+int main()
+{
+    // A nothrow_signal only accepts slots that can't throw, so it is invoked
+    // with the noexcept specifier.
+    sig::nothrow_signal<void(int)> s;
+
+    Counter counter;
+    s.connect(&Counter::add, &counter);
+    s.connect([](int i) noexcept { std::cout << "Value: " << i << std::endl; });
+
+    // Doesn't compile: the lambda isn't noexcept.
+    // s.connect([](int i) { std::cout << i << std::endl; });
+
+    static_assert(noexcept(s(1)), "The signal can't throw");
+    s(1);
+    s(2);
+
+    std::cout << "Total: " << counter.total() << std::endl;
+
+    // A regular signal reports whether any of its slots can throw.
+    sig::signal<void(int)> t;
+    t.connect([](int) noexcept {});
+    std::cout << std::boolalpha << "nothrow: " << t.nothrow() << std::endl;
+    t.connect([](int) {});
+    std::cout << "nothrow: " << t.nothrow() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "signals.hpp"
+#include <iostream>
+#include <memory>
+
+class Gain
+{
+public:
+    explicit Gain(float gain)
+        : m_Gain(gain)
+    {}
+
+    float process(float sample) const
+    {
+        return sample * m_Gain;
+    }
+
+private:
+    float m_Gain;
+};
+
+int main()
+{
+    // Define a signal that takes a sample and returns the sum of the processed samples.
+    // The combiner reduces the results on the stack, so it doesn't allocate memory.
+    using signal = sig::signal<float(float), sig::sum_value<float>>;
+    signal s;
+
+    // Connect the slots before processing starts.
+    Gain half(0.5f);
+    auto quarter = std::make_shared<Gain>(0.25f);
+
+    s.connect(&Gain::process, &half);
+    s.connect(&Gain::process, quarter);
+    s.connect([](float sample) { return -sample; });
+
+    // Invoking the signal (for example, on an audio thread) doesn't allocate memory.
+    float output = 0.0f;
+    for (int i = 1; i <= 4; ++i)
+    {
+        output += *s(static_cast<float>(i));
+    }
+
+    std::cout << "Output: " << output << std::endl;
+
+    return 0;
+}
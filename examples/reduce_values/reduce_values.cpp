@@ -0,0 +1,30 @@
+#include "signals.hpp"
+#include <iostream>
+
+float product(float x, float y) { return x * y; }
+float quotient(float x, float y) { return x / y; }
+float sum(float x, float y) { return x + y; }
+float difference(float x, float y) { return x - y; }
+
+int main()
+{
+    // Define signals that take two floats and reduce the
+    // return values of the connected slots to a single float.
+    sig::signal<float(float, float), sig::sum_value<float>> s1;
+    sig::signal<float(float, float), sig::max_value<float>> s2;
+    sig::signal<float(float, float), sig::mean_value<float>> s3;
+
+    // Connect all of the functions to the signals.
+    for (auto f : { &product, &quotient, &sum, &difference })
+    {
+        s1.connect(f);
+        s2.connect(f);
+        s3.connect(f);
+    }
+
+    std::cout << "Sum: " << *s1(6.0f, 3.0f) << std::endl;
+    std::cout << "Maximum: " << *s2(6.0f, 3.0f) << std::endl;
+    std::cout << "Mean: " << *s3(6.0f, 3.0f) << std::endl;
+
+    return 0;
+}
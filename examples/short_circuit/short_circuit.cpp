@@ -0,0 +1,42 @@
+#include "signals.hpp"
+#include <iostream>
+#include <string>
+
+bool not_empty(const std::string& name)
+{
+    std::cout << "not_empty" << std::endl;
+    return !name.empty();
+}
+
+bool not_root(const std::string& name)
+{
+    std::cout << "not_root" << std::endl;
+    return name != "root";
+}
+
+bool not_too_long(const std::string& name)
+{
+    std::cout << "not_too_long" << std::endl;
+    return name.size() < 16;
+}
+
+int main()
+{
+    // Define a signal that takes a user name and returns a bool.
+    // The all_of combiner stops invoking slots after the first slot returns false.
+    using signal = sig::signal<bool(const std::string&), sig::all_of>;
+    signal s;
+
+    // Connect the validators to the signal.
+    s.connect(&not_empty);
+    s.connect(&not_root);
+    s.connect(&not_too_long);
+
+    // Invoke the signal.
+    // The last validator is not invoked because not_root returns false.
+    bool allowed = s("root");
+
+    std::cout << std::boolalpha << "Allowed: " << allowed << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+// Enable the signal counters.
+// All translation units of a program must use the same value.
+#define SIG_SIGNAL_STATS 1
+
+#include "signals.hpp"
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    // Define a signal that takes an int and returns void.
+    using signal = sig::signal<void(int)>;
+    signal s;
+    s.set_name("updated");
+
+    // Connect and disconnect slots from two threads while the signal is invoked.
+    auto churn = [&s]()
+    {
+        for (int i = 0; i < 10000; ++i)
+        {
+            auto c = s.connect([](int) {});
+            s(i);
+            c.disconnect();
+        }
+    };
+
+    std::thread t1(churn);
+    std::thread t2(churn);
+    t1.join();
+    t2.join();
+
+    // Query the counters of all signals.
+    for (const auto& stats : sig::collect_signal_stats())
+    {
+        std::cout << "Signal: " << (stats.name ? stats.name : "(unnamed)") << std::endl;
+        std::cout << "Lock acquisitions: " << stats.lock_acquisitions << std::endl;
+        std::cout << "Contended acquisitions: " << stats.contended_acquisitions << std::endl;
+        std::cout << "Wait time: " << stats.wait_ns << " ns" << std::endl;
+        std::cout << "Copy-on-write copies: " << stats.cow_copies << std::endl;
+        std::cout << "Bytes copied: " << stats.bytes_copied << std::endl;
+        std::cout << "Peak slots: " << stats.peak_slots << std::endl;
+    }
+
+    return 0;
+}
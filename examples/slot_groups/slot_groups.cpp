@@ -0,0 +1,43 @@
+#include "signals.hpp"
+#include <iostream>
+
+void hello()
+{
+    std::cout << "Hello";
+}
+
+void world()
+{
+    std::cout << ", World";
+}
+
+void exclamation()
+{
+    std::cout << "!" << std::endl;
+}
+
+void greeting()
+{
+    std::cout << "Greeting: ";
+}
+
+int main()
+{
+    // Define a signal that takes no arguments and returns void.
+    using signal = sig::signal<void()>;
+    signal s;
+
+    // Connect the slots in a different order than they should be invoked.
+    // Ungrouped slots connected at the back are invoked after all groups.
+    s.connect(&exclamation);
+    // Grouped slots are invoked in ascending group order.
+    s.connect(1, &world);
+    s.connect(0, &hello);
+    // Ungrouped slots connected at the front are invoked before all groups.
+    s.connect(&greeting, sig::at_front);
+
+    // Call the signal.
+    s();
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "signals.hpp"
+#include <iostream>
+#include <vector>
+
+// A large callable object that is owned by a subsystem.
+class Histogram
+{
+public:
+    Histogram()
+        : m_Bins(1024, 0)
+    {}
+
+    // The histogram is not copied when it is connected with sig::ref.
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void operator()(int value)
+    {
+        ++m_Bins[static_cast<std::size_t>(value) % m_Bins.size()];
+    }
+
+    int count(int value) const
+    {
+        return m_Bins[static_cast<std::size_t>(value) % m_Bins.size()];
+    }
+
+private:
+    std::vector<int> m_Bins;
+};
+
+int main()
+{
+    using signal = sig::signal<void(int)>;
+    signal s;
+
+    // The histogram must outlive the connection.
+    Histogram histogram;
+    s.connect(sig::ref(histogram));
+
+    s(3);
+    s(3);
+    s(5);
+
+    // Disconnect the slot that refers to the histogram.
+    s.disconnect(sig::ref(histogram));
+    s(3);
+
+    std::cout << "Count of 3: " << histogram.count(3) << std::endl;
+    std::cout << "Count of 5: " << histogram.count(5) << std::endl;
+
+    return 0;
+}
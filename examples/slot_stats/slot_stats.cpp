@@ -0,0 +1,36 @@
+// Enable the slot latency histograms.
+// All translation units of a program must use the same value.
+#define SIG_SLOT_STATS 1
+
+#include "signals.hpp"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    // Define a signal that takes an int and returns void.
+    using signal = sig::signal<void(int)>;
+    signal s;
+
+    // A slot that is sometimes slow.
+    auto c = s.connect([](int i)
+    {
+        if (i % 100 == 99)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s(i);
+    }
+
+    // Query the latency histogram of the slot.
+    const auto stats = c.stats();
+    std::cout << "Invocations: " << stats.count() << std::endl;
+    std::cout << "p50: " << stats.percentile(50) << " ns" << std::endl;
+    std::cout << "p99.9: " << stats.percentile(99.9) << " ns" << std::endl;
+    std::cout << "max: " << stats.max_ns() << " ns" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+// Enable the recording of trace events.
+// All translation units of a program must use the same value.
+#define SIG_TRACE 1
+
+#include "signals.hpp"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    // Define a signal that takes an int and returns void.
+    using signal = sig::signal<void(int)>;
+    signal s;
+
+    // Give the signal a name that is shown in the trace.
+    s.set_name("frame");
+
+    s.connect([](int) { std::this_thread::sleep_for(std::chrono::microseconds(100)); });
+    s.connect([](int) { std::this_thread::sleep_for(std::chrono::microseconds(300)); });
+
+    // Record the invocations of the signal and its slots.
+    sig::trace::start();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        s(i);
+    }
+
+    sig::trace::stop();
+
+    // Open the trace in chrome://tracing or https://ui.perfetto.dev.
+    if (sig::trace::save("signals_trace.json"))
+    {
+        std::cout << "Trace written to signals_trace.json" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include "signals.hpp"
+#include <iostream>
+
+struct Physics
+{
+    void update(float dt)
+    {
+        std::cout << "Physics: " << dt << std::endl;
+    }
+};
+
+struct Audio
+{
+    void update(float dt)
+    {
+        std::cout << "Audio: " << dt << std::endl;
+    }
+};
+
+int main()
+{
+    // The order in which the slots are invoked doesn't matter, so store the
+    // slots of the same type next to each other.
+    using signal = sig::signal<void(float), sig::optional_last_value<void>, sig::type_grouped_slots<>>;
+    signal update;
+
+    Physics physics[2];
+    Audio audio[2];
+
+    update.connect(&Physics::update, &physics[0]);
+    update.connect(&Audio::update, &audio[0]);
+    update.connect(&Physics::update, &physics[1]);
+    update.connect(&Audio::update, &audio[1]);
+
+    // The physics slots are invoked back-to-back, followed by the audio slots.
+    update(0.5f);
+
+    return 0;
+}
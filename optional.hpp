@@ -505,14 +505,32 @@ namespace opt
         };
 
         // Trivilally-copyable version of the storage
+        // The value is stored in a union so that T does not need to be default
+        // constructible and the optional is trivially copyable and trivially
+        // destructible (and can be passed and returned in registers).
         template<class T>
         class tc_optional_base : public optional_tag
         {
         private:
             using this_type = tc_optional_base<T>;
 
-            bool m_initialized;
-            T    m_storage;
+            union storage_type
+            {
+                constexpr storage_type() noexcept
+                    : m_dummy()
+                {}
+
+                template<class... Args>
+                constexpr explicit storage_type(in_place_t, Args&&... args)
+                    : m_value(std::forward<Args>(args)...)
+                {}
+
+                char m_dummy;
+                T    m_value;
+            };
+
+            bool         m_initialized;
+            storage_type m_storage;
 
         protected:
             using value_type = T;
@@ -536,12 +554,12 @@ namespace opt
 
             tc_optional_base(init_value_tag, argument_type val)
                 : m_initialized(true)
-                , m_storage{val}
+                , m_storage(in_place, val)
             {}
 
             tc_optional_base(bool cond, argument_type val)
                 : m_initialized(cond)
-                , m_storage{val}
+                , m_storage(in_place, val)
             {}
 
             //template<class Expr>
@@ -562,9 +580,9 @@ namespace opt
             void assign(optional<U> const& rhs)
             {
                 if (rhs.is_initialized())
-                    m_storage = rhs.get();
-
-                m_initialized = rhs.is_initialized();
+                    construct(rhs.get());
+                else
+                    destroy();
             }
 
             // move-assigns from another _convertible_ optional<U> (deep-moves from the rhs value)
@@ -574,9 +592,9 @@ namespace opt
                 using ref_type = typename optional<U>::rval_reference_type;
 
                 if (rhs.is_initialized())
-                    m_storage = static_cast<ref_type>(rhs.get());
-
-                m_initialized = rhs.is_initialized();
+                    construct(static_cast<ref_type>(rhs.get()));
+                else
+                    destroy();
             }
 
             void assign(argument_type val)
@@ -619,7 +637,7 @@ namespace opt
         protected:
             void construct(argument_type val)
             {
-                m_storage = val;
+                ::new (get_ptr_impl()) value_type(val);
                 m_initialized = true;
             }
 
@@ -628,14 +646,14 @@ namespace opt
             template<class... Args>
             void construct(in_place_t, Args&&... args)
             {
-                m_storage = value_type(std::forward<Args>(args)...);
+                ::new (get_ptr_impl()) value_type(std::forward<Args>(args)...);
                 m_initialized = true;
             }
 
             template<class U, class... Args, typename = detail::traits::enable_if_t<std::is_constructible<T, std::initializer_list<U>>::value>>
             void construct(in_place_t, std::initializer_list<U> il, Args&&... args)
             {
-                m_storage = value_type(il, std::forward<Args>(args)...);
+                ::new (get_ptr_impl()) value_type(il, std::forward<Args>(args)...);
                 m_initialized = true;
             }
 
@@ -699,32 +717,32 @@ namespace opt
 
             void assign_value(argument_type val)
             {
-                m_storage = val;
+                ::new (get_ptr_impl()) value_type(val);
             }
 
             void assign_value(rval_reference_type val)
             {
-                m_storage = static_cast<rval_reference_type>(val);
+                ::new (get_ptr_impl()) value_type(static_cast<rval_reference_type>(val));
             }
 
             reference_const_type get_impl() const
             {
-                return m_storage;
+                return m_storage.m_value;
             }
 
             reference_type get_impl()
             {
-                return m_storage;
+                return m_storage.m_value;
             }
 
             pointer_const_type get_ptr_impl() const
             {
-                return std::addressof(m_storage);
+                return std::addressof(m_storage.m_value);
             }
 
             pointer_type get_ptr_impl()
             {
-                return std::addressof(m_storage);
+                return std::addressof(m_storage.m_value);
             }
 
             void destroy()
@@ -735,9 +753,12 @@ namespace opt
 
         namespace config
         {
+            // Trivially copyable types (which includes all scalar types) use
+            // direct storage so that optional<T> is also trivially copyable.
             template <typename T>
             struct optional_uses_direct_storage_for
-                : traits::conditional_t<std::is_scalar<T>::value && !std::is_const<T>::value && !std::is_volatile<T>::value
+                : traits::conditional_t<std::is_trivially_copyable<T>::value && std::is_copy_constructible<T>::value
+                && !std::is_const<T>::value && !std::is_volatile<T>::value
                 , std::true_type, std::false_type>
             {};
 
@@ -833,8 +854,8 @@ namespace opt
         // Can throw if T::T(T&&) does
         optional(optional&& rhs) = default;
 
-        //  On old MSVC compilers the implicitly declared dtor is not called
-        ~optional() {}
+        // Defaulted so that optional<T> is trivially destructible if T is.
+        ~optional() = default;
 
         // Copy-assigns from another convertible optional<U> (converts && deep-copies the rhs value)
         // Requires a valid conversion from U to T.
@@ -1057,7 +1078,7 @@ namespace opt
         constexpr optional() noexcept : ref(nullptr) {}
         constexpr optional(nullopt_t) noexcept : ref(nullptr) {}
         constexpr optional(T& v) noexcept : ref(std::addressof(v)) {}
-        constexpr optional(const optional& rhs) noexcept : ref(rhs.ref) {}
+        constexpr optional(const optional& rhs) noexcept = default;
         explicit constexpr optional(in_place_t, T& v) noexcept : ref(std::addressof(v)) {}
 
         optional(T&&) = delete;
@@ -17,17 +17,111 @@
   */
 
 #include "optional.hpp" // for opt::optional
-#include <atomic>       // for std::atomic_bool
+#include <algorithm>    // for std::rotate, std::move, std::find, std::lower_bound, std::upper_bound, and std::max
+#include <atomic>       // for std::atomic_bool, and std::atomic_thread_fence
 #include <cstddef>      // for std::size_t and std::nullptr_t
 #include <exception>    // for std::exception
-#include <functional>   // for std::reference_wrapper
-#include <memory>       // for std::unique_ptr
+#include <functional>   // for std::reference_wrapper, and std::invoke
+#include <iterator>     // for std::input_iterator_tag, std::distance and std::advance
+#include <list>         // for std::list
+#include <memory>       // for std::unique_ptr, and std::addressof
 #include <mutex>        // for std::mutex, and std::lock_guard
+#include <thread>       // for std::thread::id
 #include <tuple>        // for std::tuple, and std::make_tuple
 #include <type_traits>  // for std::decay, and std::enable_if
-#include <utility>      // for std::declval.
+#include <typeinfo>     // for typeid
+#include <utility>      // for std::declval, and std::index_sequence
 #include <vector>       // for std::vector
 
+// The default number of slots that are stored inside the signal object.
+// Define SIG_INLINE_SLOTS before including this file to change the default
+// for all signals or use sig::inline_slots<N> to change it per signal.
+#ifndef SIG_INLINE_SLOTS
+#define SIG_INLINE_SLOTS 4
+#endif
+
+// The number of signals that a signal can (directly or indirectly) forward to
+// before invoking it allocates memory for the slot lists of the targets.
+#ifndef SIG_INLINE_FORWARDS
+#define SIG_INLINE_FORWARDS 4
+#endif
+
+// The reduction combiners (sig::sum_value, sig::min_value, sig::max_value,
+// and sig::mean_value) use SSE or AVX kernels when they are enabled by the
+// compiler. Define SIG_NO_SIMD to always use the portable kernels.
+#if !defined(SIG_NO_SIMD)
+#if defined(__AVX__)
+#define SIG_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIG_SSE2 1
+#endif
+#endif
+
+// Define SIG_SLOT_STATS to 1 to record a latency histogram for every slot.
+// The histogram of a slot is available through connection::stats().
+// When SIG_SLOT_STATS is 0 (the default), slots are not instrumented.
+// All translation units of a program must use the same value.
+#ifndef SIG_SLOT_STATS
+#define SIG_SLOT_STATS 0
+#endif
+
+// Define SIG_TRACE to 1 to record the invocations of signals and slots
+// into per-thread ring buffers that can be written as a Chrome trace
+// (see sig::trace). When SIG_TRACE is 0 (the default), nothing is recorded.
+// SIG_TRACE_BUFFER_SIZE is the number of events per thread (a power of two).
+#ifndef SIG_TRACE
+#define SIG_TRACE 0
+#endif
+
+#ifndef SIG_TRACE_BUFFER_SIZE
+#define SIG_TRACE_BUFFER_SIZE 65536
+#endif
+
+// Define SIG_SIGNAL_STATS to 1 to count the lock acquisitions, the lock contention
+// and the copy-on-write copies of the slot list of every signal.
+// The counters are available through signal::stats() and sig::collect_signal_stats().
+// All translation units of a program must use the same value.
+#ifndef SIG_SIGNAL_STATS
+#define SIG_SIGNAL_STATS 0
+#endif
+
+// SIG_CPP17 is 1 if the library is compiled as C++17 (or later). The library
+// then uses the standard type traits, std::invoke, and if constexpr instead of
+// its own C++11 implementations, which reduces the number of templates that
+// are instantiated for every signal signature.
+// Define SIG_CPP17 to 0 to use the C++11 implementations.
+#ifndef SIG_CPP17
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define SIG_CPP17 1
+#else
+#define SIG_CPP17 0
+#endif
+#endif
+
+// The number of bytes ahead of the invoked slot that a sig::fanout_signal
+// prefetches. Define SIG_PREFETCH_DISTANCE to 0 to disable prefetching.
+#ifndef SIG_PREFETCH_DISTANCE
+#define SIG_PREFETCH_DISTANCE 512
+#endif
+
+#if SIG_SLOT_STATS || SIG_TRACE || SIG_SIGNAL_STATS
+#include <chrono>       // for std::chrono::steady_clock
+#include <cstdint>      // for std::uint64_t
+#endif
+
+#if SIG_TRACE
+#include <fstream>      // for std::ofstream
+#include <ostream>      // for std::ostream
+#include <string>       // for std::string
+#endif
+
+#if defined(SIG_AVX)
+#include <immintrin.h>  // for AVX intrinsics
+#elif defined(SIG_SSE2)
+#include <emmintrin.h>  // for SSE2 intrinsics
+#endif
+
 namespace sig
 {
     // An exception of type not_comparable_exception is thrown
@@ -35,6 +129,16 @@ namespace sig
     class not_comparable_exception : public std::exception
     {};
 
+    // An exception of type not_copyable_exception is thrown
+    // if one tries to copy a slot whose function object can only be moved.
+    class not_copyable_exception : public std::exception
+    {};
+
+    // An exception of type forwarding_cycle_exception is thrown
+    // if forwarding a signal would result in a forwarding cycle.
+    class forwarding_cycle_exception : public std::exception
+    {};
+
     // Pointers that can be converted to a weak pointer concept for 
     // tracking purposes must implement the to_weak() function in order
     // to make use of Argument-dependent lookup (ADL) and to convert
@@ -53,1816 +157,6539 @@ namespace sig
 
     // Forward declare signal class so that it can be 
     // a friend of a class in a nested namespace.
-    template<typename, typename>
+    template<typename, typename, typename>
     class signal;
 
+    template<typename, typename, typename, typename>
+    class keyed_signal;
+
+    class connection_handle;
+
+#if SIG_SLOT_STATS
     namespace detail
     {
-        namespace traits
-        {
-            // Since C++17
-            // @see https://en.cppreference.com/w/cpp/types/void_t
-            template<typename... Ts>
-            struct make_void
-            {
-                typedef void type;
-            };
+        class slot_latency;
+    }
 
-            template<typename... Ts>
-            using void_t = typename make_void<Ts...>::type;
+    /**
+     * A snapshot of the latency histogram of a slot.
+     *
+     * Latencies are recorded in nanoseconds into log-linear buckets (similar to
+     * an HDR histogram): values below 8 ns have their own bucket and every power
+     * of two above that is split into 8 buckets, so the relative error of a
+     * bucket is at most 12.5%. Latencies above 2^40 ns are counted in the last bucket.
+     */
+    class latency_histogram
+    {
+    public:
+        static constexpr std::size_t sub_buckets = 8;
+        static constexpr std::size_t num_buckets = sub_buckets + (40 - 3) * sub_buckets;
+
+        latency_histogram() noexcept
+            : m_Buckets()
+            , m_Count(0)
+            , m_Total(0)
+            , m_Max(0)
+        {}
 
-            // Since C++14
-            template<typename T>
-            using decay_t = typename std::decay<T>::type;
+        // The bucket that a latency is recorded in.
+        static std::size_t bucket(std::uint64_t ns) noexcept
+        {
+            if (ns < sub_buckets) return static_cast<std::size_t>(ns);
 
-            // Since C++14
-            template< bool B, typename T = void >
-            using enable_if_t = typename std::enable_if<B, T>::type;
+            std::size_t exponent = 0;
+            for (auto v = ns; v >>= 1;) ++exponent;
 
-            // Since C++14
-            template<bool B, typename T, typename F>
-            using conditional_t = typename std::conditional<B, T, F>::type;
+            const auto index = sub_buckets + (exponent - 3) * sub_buckets + ((ns >> (exponent - 3)) & (sub_buckets - 1));
+            return index < num_buckets ? index : num_buckets - 1;
+        }
 
-            // Since C++14
-            template<typename T>
-            using remove_cv_t = typename std::remove_cv<T>::type;
+        // The largest latency that is recorded in the bucket.
+        static std::uint64_t upper_bound(std::size_t bucket) noexcept
+        {
+            if (bucket < sub_buckets) return bucket;
 
-            // Since C++14
-            template<typename T>
-            using remove_reference_t = typename std::remove_reference<T>::type;
+            const auto exponent = (bucket - sub_buckets) / sub_buckets + 3;
+            const auto sub = (bucket - sub_buckets) % sub_buckets;
+            return ((sub_buckets + sub + 1) << (exponent - 3)) - 1;
+        }
 
-            // Since C++20
-            template<typename T>
-            struct remove_cvref {
-                using type = remove_cv_t<remove_reference_t<T>>;
-            };
+        // The number of recorded invocations.
+        std::uint64_t count() const noexcept
+        {
+            return m_Count;
+        }
 
-            template<typename T>
-            using remove_cvref_t = typename remove_cvref<T>::type;
+        // The sum of all recorded latencies.
+        std::uint64_t total_ns() const noexcept
+        {
+            return m_Total;
+        }
 
-            // Type used to indicate SFINAE success.
-            template<typename T>
-            struct success_type
-            {
-                using type = T;
-            };
+        // The largest recorded latency.
+        std::uint64_t max_ns() const noexcept
+        {
+            return m_Max;
+        }
 
-            // Type used to indicate SFINAE failure.
-            struct failure_type
-            {};
+        double mean_ns() const noexcept
+        {
+            return m_Count ? static_cast<double>(m_Total) / static_cast<double>(m_Count) : 0.0;
+        }
 
-            // Detect reference wrapper
-            // @see https://stackoverflow.com/questions/40430692/how-to-detect-stdreference-wrapper-in-c-at-compile-time
-            template <typename T>
-            struct is_reference_wrapper : std::false_type {};
-            template <typename U>
-            struct is_reference_wrapper<std::reference_wrapper<U>> : std::true_type {};
+        // The number of invocations that were recorded in the bucket.
+        std::uint64_t bucket_count(std::size_t bucket) const noexcept
+        {
+            return m_Buckets[bucket];
+        }
 
-            // Test for equality comparable
-            // @see C++ Templates: The Complete Guide (David Vandevoorde, et. al., 2018)
-            template<typename T>
-            struct is_equality_comparable
-            {
-            private:
-                // Test convertibility of == and !(==) to bool:
-                static void* conv(bool);
+        // An upper bound for the latency at the given percentile (0-100).
+        std::uint64_t percentile(double p) const noexcept
+        {
+            if (m_Count == 0) return 0;
 
-                template<typename U>
-                static std::true_type test(
-                    decltype(conv(std::declval<const U&>() == std::declval<const U&>())),
-                    decltype(conv(!(std::declval<const U&>() == std::declval<const U&>())))
-                );
+            const auto rank = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(m_Count) + 0.5);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < num_buckets; ++i)
+            {
+                seen += m_Buckets[i];
+                if (seen >= rank && seen > 0)
+                {
+                    const auto bound = upper_bound(i);
+                    return bound < m_Max ? bound : m_Max;
+                }
+            }
 
-                // Fallback
-                template<typename U>
-                static std::false_type test(...);
+            return m_Max;
+        }
 
-            public:
-                static constexpr bool value = decltype(test<T>(nullptr, nullptr))::value;
-            };
+    private:
+        friend class detail::slot_latency;
 
-            // Detect if type supports weak_ptr semantics.
-            template<typename T, typename = void>
-            struct is_weak_ptr : std::false_type
-            {};
+        std::uint64_t m_Buckets[num_buckets];
+        std::uint64_t m_Count;
+        std::uint64_t m_Total;
+        std::uint64_t m_Max;
+    };
+#endif
 
-            template<typename T>
-            struct is_weak_ptr<T, void_t<decltype(std::declval<T>().expired()),
-                decltype(std::declval<T>().lock()),
-                decltype(std::declval<T>().reset())>>
-                : std::true_type
-            {};
+#if SIG_TRACE
+    namespace detail
+    {
+        struct trace_event
+        {
+            const char* name;       // Must have static storage duration.
+            const char* category;
+            const void* id;         // The address of the signal or slot.
+            std::uint64_t ts;       // Nanoseconds of the steady clock.
+            char phase;             // 'B' (begin) or 'E' (end).
+        };
 
-            // Test to see if a type can be converted to a weak_ptr type.
-            template <typename T, typename = void>
-            struct is_weak_ptr_convertable : std::false_type
-            {};
+        // A ring buffer of trace events that is written by a single thread.
+        // When the buffer is full, the oldest events are overwritten.
+        // The spin lock is only contended while the buffer is being read.
+        class trace_buffer
+        {
+        public:
+            static constexpr std::size_t capacity = SIG_TRACE_BUFFER_SIZE;
+            static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "SIG_TRACE_BUFFER_SIZE must be a power of two.");
+
+            explicit trace_buffer(std::uint32_t tid)
+                : m_Events(capacity)
+                , m_Next(0)
+                , m_Size(0)
+                , m_Tid(tid)
+            {
+                m_Lock.clear();
+            }
 
-            template <typename T>
-            struct is_weak_ptr_convertable<T, void_t<decltype(to_weak(std::declval<T>()))>>
-                : is_weak_ptr<decltype(to_weak(std::declval<T>()))>
-            {};
+            void record(const char* name, const char* category, const void* id, char phase) noexcept
+            {
+                const auto ts = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
 
-            // Primary template for extracting function traits.
-            template<typename Func>
-            struct function_traits;
+                while (m_Lock.test_and_set(std::memory_order_acquire))
+                {}
 
-            template<typename R, typename... Args>
-            struct function_traits<R(Args...)>
-            {
-                using result_type = R;
-            };
+                m_Events[m_Next] = trace_event{ name, category, id, ts, phase };
+                m_Next = (m_Next + 1) & (capacity - 1);
+                if (m_Size < capacity) ++m_Size;
 
-            // Used by result_of, invoke etc. to unwrap a reference_wrapper.
-            template<typename T, typename U = remove_cvref_t<T>>
-            struct inv_unwrap
-            {
-                using type = T;
-            };
+                m_Lock.clear(std::memory_order_release);
+            }
 
-            template<typename T, typename U>
-            struct inv_unwrap<T, std::reference_wrapper<U>>
+            // Copy the events from oldest to newest.
+            std::vector<trace_event> events()
             {
-                using type = U&;
-            };
+                std::vector<trace_event> result;
+                result.reserve(m_Size);
 
-            template<typename T>
-            using inv_unwrap_t = typename inv_unwrap<T>::type;
+                while (m_Lock.test_and_set(std::memory_order_acquire))
+                {}
 
-            // Primary template for result_of.
-            // 
-            template<typename Func>
-            struct result_of;
+                const auto first = (m_Next + capacity - m_Size) & (capacity - 1);
+                for (std::size_t i = 0; i < m_Size; ++i)
+                {
+                    result.push_back(m_Events[(first + i) & (capacity - 1)]);
+                }
 
-            // Invoke tags.
-            struct invoke_func{};
-            struct invoke_memfun_ref{};
-            struct invoke_memfun_deref{};
-            struct invoke_memobj_ref{};
-            struct invoke_memobj_deref{};
+                m_Lock.clear(std::memory_order_release);
+                return result;
+            }
 
-            // Associate a tag with a specialization of success_type
-            template<typename T, typename Tag>
-            struct result_of_success : success_type<T>
+            void clear() noexcept
             {
-                using invoke_type = Tag;
-            };
+                while (m_Lock.test_and_set(std::memory_order_acquire))
+                {}
 
-            // Determine result of calling a function object.
-            struct result_of_func_impl
-            {
-                template<typename Func, typename... Args>
-                static result_of_success<decltype(std::declval<Func>()(std::declval<Args>()...)), invoke_func>
-                test(int);
+                m_Size = 0;
 
-                // Fallback on failure.
-                template<typename...>
-                static failure_type test(...);
-            };
+                m_Lock.clear(std::memory_order_release);
+            }
 
-            // Determine the result of calling a pointer to member function
-            // for reference types.
-            struct result_of_memfun_ref_impl
+            std::uint32_t tid() const noexcept
             {
-                template<typename Func, typename T, typename... Args>
-                static result_of_success<decltype((std::declval<T>().*std::declval<Func>())(std::declval<Args>()...)), invoke_memfun_ref>
-                test(int);
+                return m_Tid;
+            }
 
-                // Fallback on failure.
-                template<typename...>
-                static failure_type test(...);
-            };
+        private:
+            std::vector<trace_event> m_Events;
+            std::size_t m_Next;
+            std::size_t m_Size;
+            std::uint32_t m_Tid;
+            std::atomic_flag m_Lock;
+        };
 
-            template<typename Func, typename Arg, typename... Args>
-            struct result_of_memfun_ref : private result_of_memfun_ref_impl
+        // Owns the trace buffers of all threads.
+        // Buffers are kept after their thread exits so that they can still be written.
+        class trace_registry
+        {
+        public:
+            static trace_registry& instance()
             {
-                using type = decltype(test<Func, Arg, Args...>(0));
-            };
+                static trace_registry registry;
+                return registry;
+            }
 
-            template<typename Func, typename Arg, typename... Args>
-            using result_of_memfun_ref_t = typename result_of_memfun_ref<Func, Arg, Args...>::type;
+            // The trace buffer of the calling thread.
+            trace_buffer& local()
+            {
+                thread_local std::shared_ptr<trace_buffer> buffer = create();
+                return *buffer;
+            }
 
-            // Determine the result of calling a pointer to member function
-            // for pointer types.
-            struct result_of_memfun_deref_impl
+            std::vector<std::shared_ptr<trace_buffer>> buffers()
             {
-                template<typename Func, typename T, typename... Args>
-                static result_of_success<decltype(((*std::declval<T>()).*std::declval<Func>())(std::declval<Args>()...)), invoke_memfun_deref>
-                test(int);
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                return m_Buffers;
+            }
 
-                // Fallback on failure.
-                template<typename...>
-                static failure_type test(...);
-            };
+            std::atomic_bool enabled;
+            std::atomic<std::uint64_t> dropped;     // Scopes that could not be recorded.
 
-            template<typename Func, typename Arg, typename... Args>
-            struct result_of_memfun_deref : private result_of_memfun_deref_impl
+        private:
+            trace_registry()
+                : enabled(false)
+                , dropped(0)
+            {}
+
+            std::shared_ptr<trace_buffer> create()
             {
-                using type = decltype(test<Func, Arg, Args...>(0));
-            };
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                auto buffer = std::make_shared<trace_buffer>(static_cast<std::uint32_t>(m_Buffers.size() + 1));
+                m_Buffers.push_back(buffer);
+                return buffer;
+            }
 
-            template<typename Func, typename Arg, typename... Args>
-            using result_of_memfun_deref_t = typename result_of_memfun_deref<Func, Arg, Args...>::type;
+            std::mutex m_Mutex;
+            std::vector<std::shared_ptr<trace_buffer>> m_Buffers;
+        };
 
-            // Determine the result of a pointer to member data.
-            // for reference types.
-            struct result_of_memobj_ref_impl
+        // Records a begin event on construction and an end event on destruction
+        // if tracing is enabled.
+        // The first scope of a thread allocates the trace buffer of the thread.
+        // If that fails, the scope is dropped and counted instead of throwing.
+        class trace_scope
+        {
+        public:
+            trace_scope(const char* name, const char* category, const void* id) noexcept
+                : m_Buffer(nullptr)
+                , m_Name(name)
+                , m_Category(category)
+                , m_Id(id)
             {
-                template<typename F, typename T>
-                static result_of_success<decltype(std::declval<T>().*std::declval<F>()), invoke_memobj_ref>
-                test(int);
-
-                template<typename, typename>
-                static failure_type test(...);
-            };
+                auto& registry = trace_registry::instance();
+                if (registry.enabled.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        m_Buffer = &registry.local();
+                    }
+                    catch (...)
+                    {
+                        registry.dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    m_Buffer->record(m_Name, m_Category, m_Id, 'B');
+                }
+            }
 
-            template<typename MemPtr, typename Arg>
-            struct result_of_memobj_ref : private result_of_memobj_ref_impl
+            ~trace_scope()
             {
-                using type = decltype(test<MemPtr, Arg>(0));
-            };
+                if (m_Buffer)
+                {
+                    m_Buffer->record(m_Name, m_Category, m_Id, 'E');
+                }
+            }
 
-            template<typename MemPtr, typename Arg>
-            using result_of_memobj_ref_t = typename result_of_memobj_ref<MemPtr, Arg>::type;
+            trace_scope(const trace_scope&) = delete;
+            trace_scope& operator=(const trace_scope&) = delete;
 
-            // Determine the result of a pointer to member data for
-            // pointer types.
-            struct result_of_memobj_deref_impl
+        private:
+            trace_buffer* m_Buffer;
+            const char* m_Name;
+            const char* m_Category;
+            const void* m_Id;
+        };
+
+        inline void write_json_string(std::ostream& os, const char* str)
+        {
+            os << '"';
+            for (; *str; ++str)
             {
-                template<typename F, typename T>
-                static result_of_success<decltype((*std::declval<T>()).*std::declval<F>()), invoke_memobj_deref>
-                test(int);
-
-                template<typename, typename>
-                static failure_type test(...);
-            };
+                const auto c = *str;
+                if (c == '"' || c == '\\')
+                {
+                    os << '\\' << c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    os << ' ';
+                }
+                else
+                {
+                    os << c;
+                }
+            }
+            os << '"';
+        }
+    }
 
-            template<typename MemPtr, typename Arg>
-            struct result_of_memobj_deref : private result_of_memobj_deref_impl
-            {
-                using type = decltype(test<MemPtr, Arg>(0));
-            };
+    // Record the invocations of signals and slots in the Chrome trace event format.
+    // The trace can be viewed in chrome://tracing or https://ui.perfetto.dev.
+    // Use signal::set_name to give a signal a name in the trace.
+    namespace trace
+    {
+        // Start recording events.
+        inline void start() noexcept
+        {
+            detail::trace_registry::instance().enabled = true;
+        }
 
-            template<typename MemPtr, typename Arg>
-            using result_of_memobj_deref_t = typename result_of_memobj_deref<MemPtr, Arg>::type;
+        // Stop recording events. The recorded events are kept.
+        inline void stop() noexcept
+        {
+            detail::trace_registry::instance().enabled = false;
+        }
 
-            template<typename MemPtr, typename Arg>
-            struct result_of_memobj;
+        inline bool enabled() noexcept
+        {
+            return detail::trace_registry::instance().enabled;
+        }
 
-            template<typename Type, typename Class, typename Arg>
-            struct result_of_memobj<Type Class::*, Arg>
+        // Discard the recorded events.
+        inline void clear()
+        {
+            auto& registry = detail::trace_registry::instance();
+            for (const auto& buffer : registry.buffers())
             {
-                using ArgVal = remove_cvref_t<Arg>;
-                using MemPtr = Type Class::*;
-                using type = conditional_t<std::is_same<ArgVal, Class>::value || std::is_base_of<Class, ArgVal>::value,
-                    result_of_memobj_ref_t<MemPtr, Arg>,
-                    result_of_memobj_deref_t<MemPtr, Arg>>;
-            };
+                buffer->clear();
+            }
+            registry.dropped = 0;
+        }
 
-            template<typename MemPtr, typename Arg>
-            using result_of_memobj_t = typename result_of_memobj<MemPtr, Arg>::type;
+        // The number of signal and slot invocations that were not recorded
+        // because the trace buffer of their thread could not be allocated.
+        inline std::uint64_t dropped() noexcept
+        {
+            return detail::trace_registry::instance().dropped;
+        }
 
-            template<typename MemPtr, typename Class, typename... Args>
-            struct result_of_memfun;
+        // Write the recorded events as Chrome trace JSON.
+        inline void write_json(std::ostream& os)
+        {
+            os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
 
-            template<typename Func, typename Class, typename Arg, typename... Args>
-            struct result_of_memfun<Func Class::*, Arg, Args...>
+            bool first = true;
+            for (const auto& buffer : detail::trace_registry::instance().buffers())
             {
-                using ArgVal = remove_reference_t<Arg>;
-                using MemPtr = Func Class::*;
-                using type = conditional_t<std::is_base_of<Class, ArgVal>::value,
-                    result_of_memfun_ref_t<MemPtr, Arg, Args...>,
-                    result_of_memfun_deref_t<MemPtr, Arg, Args...>>;
-            };
+                for (const auto& e : buffer->events())
+                {
+                    os << (first ? "\n" : ",\n");
+                    first = false;
+
+                    os << "{\"name\":";
+                    detail::write_json_string(os, e.name);
+                    os << ",\"cat\":\"" << e.category << "\",\"ph\":\"" << e.phase << "\"";
+                    os << ",\"ts\":" << e.ts / 1000 << "." << static_cast<char>('0' + e.ts / 100 % 10)
+                        << static_cast<char>('0' + e.ts / 10 % 10) << static_cast<char>('0' + e.ts % 10);
+                    os << ",\"pid\":1,\"tid\":" << buffer->tid();
+                    os << ",\"args\":{\"id\":\"" << e.id << "\"}}";
+                }
+            }
 
-            template<typename Func, typename Class, typename Arg, typename... Args>
-            using result_of_memfun_t = typename result_of_memfun<Func, Class, Arg, Args...>::type;
+            os << "\n]}\n";
+        }
 
-            template<bool IsMemberObjectPointer, bool IsMemberFunctionPointer, 
-                typename Func, typename... Args>
-            struct result_of_impl
-            {
-                using type = failure_type;
-            };
+        // Write the recorded events as Chrome trace JSON to a file.
+        // @returns false if the file could not be written.
+        inline bool save(const std::string& path)
+        {
+            std::ofstream file(path);
+            if (!file) return false;
 
-            template<typename MemPtr, typename Arg>
-            struct result_of_impl<true, false, MemPtr, Arg> : result_of_memobj<decay_t<MemPtr>, inv_unwrap_t<Arg>>
-            {};
+            write_json(file);
+            return static_cast<bool>(file);
+        }
+    }
+#endif
 
-            template<typename MemPtr, typename Arg, typename... Args>
-            struct result_of_impl<false, true, MemPtr, Arg, Args...> : result_of_memfun<decay_t<MemPtr>, inv_unwrap_t<Arg>, Args...>
-            {};
+#if SIG_SIGNAL_STATS
+    /**
+     * A snapshot of the counters of a signal.
+     * The lock counters include the locks that are taken to invoke the signal.
+     * A copy-on-write copy is made when the slot list is modified
+     * while another thread is invoking the signal.
+     */
+    struct signal_stats
+    {
+        const void* id;                         // The address of the signal.
+        const char* name;                       // The debug name of the signal or nullptr.
+        std::uint64_t lock_acquisitions;        // Number of times the slot mutex was locked.
+        std::uint64_t contended_acquisitions;   // Number of times the slot mutex was already locked.
+        std::uint64_t wait_ns;                  // Total time spent waiting for the slot mutex.
+        std::uint64_t cow_copies;               // Number of copies of the slot list.
+        std::uint64_t bytes_copied;             // Total size of the copied slot lists.
+        std::size_t peak_slots;                 // Largest number of slots that were connected at once.
+    };
 
-            template<typename Func, typename... Args>
-            struct result_of_impl<false, false, Func, Args...> : private result_of_func_impl
+    namespace detail
+    {
+        // The counters of a signal.
+        // Counters are spread over a few cache line sized stripes that are
+        // selected by the calling thread and updated with relaxed atomics,
+        // so counting does not add contention between threads.
+        class signal_counters
+        {
+        public:
+            enum counter
             {
-                using type = decltype(test<Func, Args...>(0));
+                lock_acquisitions,
+                contended_acquisitions,
+                wait_ns,
+                cow_copies,
+                bytes_copied,
+                num_counters
             };
 
-            template<typename Func, typename... Args>
-            struct invoke_result : public result_of_impl<
-                std::is_member_object_pointer<remove_reference_t<Func>>::value,
-                std::is_member_function_pointer<remove_reference_t<Func>>::value,
-                Func, Args...>::type
-            {};
+            explicit signal_counters(const void* id);
+            ~signal_counters();
 
-            template<typename Func, typename... Args>
-            using invoke_result_t = typename invoke_result<Func, Args...>::type;
+            signal_counters(const signal_counters&) = delete;
+            signal_counters& operator=(const signal_counters&) = delete;
 
-            // Detect if a function type is invocable given a set of arguments.
+            void add(counter c, std::uint64_t n) noexcept
+            {
+                m_Stripes[stripe()].values[c].fetch_add(n, std::memory_order_relaxed);
+            }
 
-            // Primary template for invalid INVOKE expressions.
-            template<typename Result, typename R, bool = std::is_void<R>::value, typename = void>
-            struct is_invocable_impl : std::false_type
-            {};
+            std::uint64_t total(counter c) const noexcept
+            {
+                std::uint64_t n = 0;
+                for (const auto& s : m_Stripes)
+                {
+                    n += s.values[c].load(std::memory_order_relaxed);
+                }
+                return n;
+            }
 
-            // Valid INVOKE and INVOKE<void> expressions
-            template<typename Result, typename R>
-            struct is_invocable_impl<Result, R, true, void_t<typename Result::type>> : std::true_type
-            {};
+            // Must be called while the slot mutex is locked.
+            void update_peak(std::size_t size) noexcept
+            {
+                if (size > m_PeakSlots.load(std::memory_order_relaxed))
+                {
+                    m_PeakSlots.store(size, std::memory_order_relaxed);
+                }
+            }
 
-            // Valid INVOKE<R> expressions.
-            template<typename Result, typename R>
-            struct is_invocable_impl<Result, R, false, void_t<typename Result::type>>
+            void set_name(const char* name) noexcept
             {
-            private:
-                // The type of the INVOKE expression.
-                static typename Result::type get();
+                m_Name.store(name, std::memory_order_relaxed);
+            }
 
-                template<typename T>
-                static void conv(T);
+            signal_stats snapshot() const noexcept
+            {
+                signal_stats stats;
+                stats.id = m_Id;
+                stats.name = m_Name.load(std::memory_order_relaxed);
+                stats.lock_acquisitions = total(lock_acquisitions);
+                stats.contended_acquisitions = total(contended_acquisitions);
+                stats.wait_ns = total(wait_ns);
+                stats.cow_copies = total(cow_copies);
+                stats.bytes_copied = total(bytes_copied);
+                stats.peak_slots = m_PeakSlots.load(std::memory_order_relaxed);
+                return stats;
+            }
 
-                // This overload is viable if INVOKE(f, args...) can convert to T
-                template<typename T, typename = decltype(conv<T>(get()))>
-                static std::true_type test(int);
+            // The counters of the signal whose slot mutex was locked first
+            // by the calling thread. Copy-on-write copies are attributed to it.
+            static signal_counters*& current() noexcept
+            {
+                static thread_local signal_counters* counters = nullptr;
+                return counters;
+            }
 
-                // Fallback if failure
-                template<typename T>
-                static std::false_type test(...);
+        private:
+            static constexpr std::size_t num_stripes = 8;
 
-            public:
-                using type = decltype(test<R>(0));
+            struct stripe_type
+            {
+                std::atomic<std::uint64_t> values[num_counters];
+                char padding[64 - (num_counters * sizeof(std::uint64_t)) % 64];
             };
 
-            template<typename Func, typename... Args>
-            struct is_invocable : is_invocable_impl<invoke_result<Func, Args...>, void>::type
-            {};
-
-            template<typename R, typename Func, typename... Args>
-            struct is_invocable_r : is_invocable_impl<invoke_result<Func, Args...>, R>::type
-            {};
+            static std::size_t stripe() noexcept
+            {
+                static std::atomic<std::size_t> next(0);
+                static thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % num_stripes;
+                return index;
+            }
 
-        } // namespace traits
+            stripe_type m_Stripes[num_stripes];
+            std::atomic<std::size_t> m_PeakSlots;
+            std::atomic<const char*> m_Name;
+            const void* m_Id;
+        };
 
-        // Use is_equality_compareable to try to perform the equality check
-        // (if it is valid for the given type).
-        template<typename T, bool = traits::is_equality_comparable<T>::value>
-        struct try_equals
+        // The counters of all signals that currently exist.
+        class signal_registry
         {
-            static bool equals(const T& t1, const T& t2)
+        public:
+            static signal_registry& instance()
             {
-                return t1 == t2;
+                static signal_registry registry;
+                return registry;
             }
-        };
 
-        // Partial specialization if type is not equality comparable.
-        // In this case, throw an exception to indicate that the type is not 
-        // equality comparable.
-        template<typename T>
-        struct try_equals<T, false>
-        {
-            static bool equals(const T&, const T&)
+            void add(const signal_counters* counters)
             {
-                throw sig::not_comparable_exception();
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Counters.push_back(counters);
+            }
+
+            void remove(const signal_counters* counters)
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                auto iter = std::find(m_Counters.begin(), m_Counters.end(), counters);
+                if (iter != m_Counters.end())
+                {
+                    *iter = m_Counters.back();
+                    m_Counters.pop_back();
+                }
+            }
+
+            std::vector<signal_stats> snapshot()
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+
+                std::vector<signal_stats> result;
+                result.reserve(m_Counters.size());
+                for (auto counters : m_Counters)
+                {
+                    result.push_back(counters->snapshot());
+                }
+                return result;
             }
+
+        private:
+            signal_registry() = default;
+
+            std::mutex m_Mutex;
+            std::vector<const signal_counters*> m_Counters;
         };
 
-        // Primary template
-        // Invokes a function object.
-        // @see https://en.cppreference.com/w/cpp/types/result_of
-        template<typename>
-        struct invoke_helper
+        inline signal_counters::signal_counters(const void* id)
+            : m_PeakSlots(0)
+            , m_Name(nullptr)
+            , m_Id(id)
         {
-            // Call a function object.
-            template<typename Func, typename... Args>
-            static auto call(Func&& f, Args&&... args) -> decltype(std::forward<Func>(f)(std::forward<Args>(args)...))
+            for (auto& s : m_Stripes)
             {
-                return std::forward<Func>(f)(std::forward<Args>(args)...);
+                for (auto& v : s.values)
+                {
+                    v.store(0, std::memory_order_relaxed);
+                }
             }
-        };
 
-        // Invoke a pointer to member function or pointer to member data.
-        // @see https://en.cppreference.com/w/cpp/types/result_of
-        template<typename Type, typename Base>
-        struct invoke_helper<Type Base::*>
+            signal_registry::instance().add(this);
+        }
+
+        inline signal_counters::~signal_counters()
         {
-            // Get a reference type.
-            template<typename T, typename Td = traits::decay_t<T>,
-                typename = traits::enable_if_t<std::is_base_of<Base, Td>::value>>
-                static auto get(T&& t) -> T&&
+            signal_registry::instance().remove(this);
+        }
+
+        // A mutex that counts its acquisitions and the time spent waiting for it.
+        class counted_mutex
+        {
+        public:
+            explicit counted_mutex(const void* id)
+                : m_Counters(id)
+            {}
+
+            void lock()
             {
-                return t;
+                if (!m_Mutex.try_lock())
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    m_Mutex.lock();
+                    const auto wait = std::chrono::steady_clock::now() - start;
+
+                    m_Counters.add(signal_counters::contended_acquisitions, 1);
+                    m_Counters.add(signal_counters::wait_ns,
+                        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count()));
+                }
+                acquired();
             }
 
-            // Get a std::reference_wrapper
-            template<typename T, typename Td = traits::decay_t<T>,
-                typename = traits::enable_if_t<traits::is_reference_wrapper<Td>::value>>
-                static auto get(T&& t) -> decltype(t.get())
+            bool try_lock()
             {
-                return t.get();
+                if (!m_Mutex.try_lock()) return false;
+
+                acquired();
+                return true;
             }
 
-            // Get a pointer or pointer-like object (like smart_ptr, or unique_ptr)
-            template<typename T, typename Td = traits::decay_t<T>,
-                typename = traits::enable_if_t<!std::is_base_of<Base, Td>::value>,
-                typename = traits::enable_if_t<!traits::is_reference_wrapper<Td>::value>>
-                static auto get(T&& t) -> decltype(*std::forward<T>(t))
+            void unlock()
             {
-                return *std::forward<T>(t);
+                auto& current = signal_counters::current();
+                if (current == &m_Counters)
+                {
+                    current = nullptr;
+                }
+                m_Mutex.unlock();
             }
 
-            // Call a pointer to a member function.
-            template<typename T, typename... Args, typename Type1,
-                typename = traits::enable_if_t<std::is_function<Type1>::value>>
-                static auto call(Type1 Base::* pmf, T&& t, Args&&... args)
-                -> decltype((get(std::forward<T>(t)).*pmf)(std::forward<Args>(args)...))
+            signal_counters& counters() noexcept
             {
-                return (get(std::forward<T>(t)).*pmf)(std::forward<Args>(args)...);
+                return m_Counters;
             }
 
-            // Call a pointer to member data.
-            template<typename T>
-            static auto call(Type Base::* pmd, T&& t)
-                -> decltype(get(std::forward<T>(t)).*pmd)
+            const signal_counters& counters() const noexcept
             {
-                return get(std::forward<T>(t)).*pmd;
+                return m_Counters;
             }
+
+        private:
+            void acquired() noexcept
+            {
+                m_Counters.add(signal_counters::lock_acquisitions, 1);
+
+                auto& current = signal_counters::current();
+                if (!current)
+                {
+                    current = &m_Counters;
+                }
+            }
+
+            std::mutex m_Mutex;
+            signal_counters m_Counters;
         };
 
-        /**
-         * A copy-on-write template class to avoid unnecessary copies of
-         * data unless the data will be modified. This greatly improves
-         * the performance of the signal class in a multi-threaded environment
-         * since read-only copies only require a shared pointer copy.
-         * The copy-on-write pointer has similar semantics to shared pointers.
-         *
-         * @see API Design for C++, Martin Reddy (Elsevier, 2011).
-         */
+        // The number of bytes that are copied when a copy-on-write pointer detaches.
         template<typename T>
-        class cow_ptr
+        std::size_t cow_bytes(const T&) noexcept
+        {
+            return sizeof(T);
+        }
+
+        template<typename T, typename Allocator>
+        std::size_t cow_bytes(const std::vector<T, Allocator>& v) noexcept
+        {
+            return v.size() * sizeof(T);
+        }
+    }
+
+    // Take a snapshot of the counters of all signals that currently exist.
+    inline std::vector<signal_stats> collect_signal_stats()
+    {
+        return detail::signal_registry::instance().snapshot();
+    }
+#endif
+
+    namespace detail
+    {
+        namespace traits
+        {
+            // Since C++17
+            // @see https://en.cppreference.com/w/cpp/types/void_t
+            template<typename... Ts>
+            struct make_void
+            {
+                typedef void type;
+            };
+
+            template<typename... Ts>
+            using void_t = typename make_void<Ts...>::type;
+
+            // Since C++14
+            template<typename T>
+            using decay_t = typename std::decay<T>::type;
+
+            // Since C++14
+            template< bool B, typename T = void >
+            using enable_if_t = typename std::enable_if<B, T>::type;
+
+            // Since C++14
+            template<bool B, typename T, typename F>
+            using conditional_t = typename std::conditional<B, T, F>::type;
+
+            // Since C++14
+            template<typename T>
+            using remove_cv_t = typename std::remove_cv<T>::type;
+
+            // Since C++14
+            template<typename T>
+            using remove_reference_t = typename std::remove_reference<T>::type;
+
+            // Since C++20
+            template<typename T>
+            struct remove_cvref {
+                using type = remove_cv_t<remove_reference_t<T>>;
+            };
+
+            template<typename T>
+            using remove_cvref_t = typename remove_cvref<T>::type;
+
+            // Type used to indicate SFINAE success.
+            template<typename T>
+            struct success_type
+            {
+                using type = T;
+            };
+
+            // Type used to indicate SFINAE failure.
+            struct failure_type
+            {};
+
+            // Detect reference wrapper
+            // @see https://stackoverflow.com/questions/40430692/how-to-detect-stdreference-wrapper-in-c-at-compile-time
+            template <typename T>
+            struct is_reference_wrapper : std::false_type {};
+            template <typename U>
+            struct is_reference_wrapper<std::reference_wrapper<U>> : std::true_type {};
+
+            // Test for equality comparable
+            // @see C++ Templates: The Complete Guide (David Vandevoorde, et. al., 2018)
+            template<typename T>
+            struct is_equality_comparable
+            {
+            private:
+                // Test convertibility of == and !(==) to bool:
+                static void* conv(bool);
+
+                template<typename U>
+                static std::true_type test(
+                    decltype(conv(std::declval<const U&>() == std::declval<const U&>())),
+                    decltype(conv(!(std::declval<const U&>() == std::declval<const U&>())))
+                );
+
+                // Fallback
+                template<typename U>
+                static std::false_type test(...);
+
+            public:
+                static constexpr bool value = decltype(test<T>(nullptr, nullptr))::value;
+            };
+
+            // Detect if type supports weak_ptr semantics.
+            template<typename T, typename = void>
+            struct is_weak_ptr : std::false_type
+            {};
+
+            template<typename T>
+            struct is_weak_ptr<T, void_t<decltype(std::declval<T>().expired()),
+                decltype(std::declval<T>().lock()),
+                decltype(std::declval<T>().reset())>>
+                : std::true_type
+            {};
+
+            // Test to see if a type can be converted to a weak_ptr type.
+            template <typename T, typename = void>
+            struct is_weak_ptr_convertable : std::false_type
+            {};
+
+            template <typename T>
+            struct is_weak_ptr_convertable<T, void_t<decltype(to_weak(std::declval<T>()))>>
+                : is_weak_ptr<decltype(to_weak(std::declval<T>()))>
+            {};
+
+            // Primary template for extracting function traits.
+            template<typename Func>
+            struct function_traits;
+
+            template<typename R, typename... Args>
+            struct function_traits<R(Args...)>
+            {
+                using result_type = R;
+            };
+
+#if SIG_CPP17
+            template<typename Func, typename... Args>
+            using invoke_result = std::invoke_result<Func, Args...>;
+
+            template<typename Func, typename... Args>
+            using invoke_result_t = std::invoke_result_t<Func, Args...>;
+
+            template<typename Func, typename... Args>
+            using is_invocable = std::is_invocable<Func, Args...>;
+
+            template<typename R, typename Func, typename... Args>
+            using is_invocable_r = std::is_invocable_r<R, Func, Args...>;
+
+            template<typename Func, typename... Args>
+            using is_nothrow_invocable = std::is_nothrow_invocable<Func, Args...>;
+#else
+            // Used by result_of, invoke etc. to unwrap a reference_wrapper.
+            template<typename T, typename U = remove_cvref_t<T>>
+            struct inv_unwrap
+            {
+                using type = T;
+            };
+
+            template<typename T, typename U>
+            struct inv_unwrap<T, std::reference_wrapper<U>>
+            {
+                using type = U&;
+            };
+
+            template<typename T>
+            using inv_unwrap_t = typename inv_unwrap<T>::type;
+
+            // Primary template for result_of.
+            // 
+            template<typename Func>
+            struct result_of;
+
+            // Invoke tags.
+            struct invoke_func{};
+            struct invoke_memfun_ref{};
+            struct invoke_memfun_deref{};
+            struct invoke_memobj_ref{};
+            struct invoke_memobj_deref{};
+
+            // Associate a tag with a specialization of success_type
+            template<typename T, typename Tag>
+            struct result_of_success : success_type<T>
+            {
+                using invoke_type = Tag;
+            };
+
+            // Determine result of calling a function object.
+            struct result_of_func_impl
+            {
+                template<typename Func, typename... Args>
+                static result_of_success<decltype(std::declval<Func>()(std::declval<Args>()...)), invoke_func>
+                test(int);
+
+                // Fallback on failure.
+                template<typename...>
+                static failure_type test(...);
+            };
+
+            // Determine the result of calling a pointer to member function
+            // for reference types.
+            struct result_of_memfun_ref_impl
+            {
+                template<typename Func, typename T, typename... Args>
+                static result_of_success<decltype((std::declval<T>().*std::declval<Func>())(std::declval<Args>()...)), invoke_memfun_ref>
+                test(int);
+
+                // Fallback on failure.
+                template<typename...>
+                static failure_type test(...);
+            };
+
+            template<typename Func, typename Arg, typename... Args>
+            struct result_of_memfun_ref : private result_of_memfun_ref_impl
+            {
+                using type = decltype(test<Func, Arg, Args...>(0));
+            };
+
+            template<typename Func, typename Arg, typename... Args>
+            using result_of_memfun_ref_t = typename result_of_memfun_ref<Func, Arg, Args...>::type;
+
+            // Determine the result of calling a pointer to member function
+            // for pointer types.
+            struct result_of_memfun_deref_impl
+            {
+                template<typename Func, typename T, typename... Args>
+                static result_of_success<decltype(((*std::declval<T>()).*std::declval<Func>())(std::declval<Args>()...)), invoke_memfun_deref>
+                test(int);
+
+                // Fallback on failure.
+                template<typename...>
+                static failure_type test(...);
+            };
+
+            template<typename Func, typename Arg, typename... Args>
+            struct result_of_memfun_deref : private result_of_memfun_deref_impl
+            {
+                using type = decltype(test<Func, Arg, Args...>(0));
+            };
+
+            template<typename Func, typename Arg, typename... Args>
+            using result_of_memfun_deref_t = typename result_of_memfun_deref<Func, Arg, Args...>::type;
+
+            // Determine the result of a pointer to member data.
+            // for reference types.
+            struct result_of_memobj_ref_impl
+            {
+                template<typename F, typename T>
+                static result_of_success<decltype(std::declval<T>().*std::declval<F>()), invoke_memobj_ref>
+                test(int);
+
+                template<typename, typename>
+                static failure_type test(...);
+            };
+
+            template<typename MemPtr, typename Arg>
+            struct result_of_memobj_ref : private result_of_memobj_ref_impl
+            {
+                using type = decltype(test<MemPtr, Arg>(0));
+            };
+
+            template<typename MemPtr, typename Arg>
+            using result_of_memobj_ref_t = typename result_of_memobj_ref<MemPtr, Arg>::type;
+
+            // Determine the result of a pointer to member data for
+            // pointer types.
+            struct result_of_memobj_deref_impl
+            {
+                template<typename F, typename T>
+                static result_of_success<decltype((*std::declval<T>()).*std::declval<F>()), invoke_memobj_deref>
+                test(int);
+
+                template<typename, typename>
+                static failure_type test(...);
+            };
+
+            template<typename MemPtr, typename Arg>
+            struct result_of_memobj_deref : private result_of_memobj_deref_impl
+            {
+                using type = decltype(test<MemPtr, Arg>(0));
+            };
+
+            template<typename MemPtr, typename Arg>
+            using result_of_memobj_deref_t = typename result_of_memobj_deref<MemPtr, Arg>::type;
+
+            template<typename MemPtr, typename Arg>
+            struct result_of_memobj;
+
+            template<typename Type, typename Class, typename Arg>
+            struct result_of_memobj<Type Class::*, Arg>
+            {
+                using ArgVal = remove_cvref_t<Arg>;
+                using MemPtr = Type Class::*;
+                using type = conditional_t<std::is_same<ArgVal, Class>::value || std::is_base_of<Class, ArgVal>::value,
+                    result_of_memobj_ref_t<MemPtr, Arg>,
+                    result_of_memobj_deref_t<MemPtr, Arg>>;
+            };
+
+            template<typename MemPtr, typename Arg>
+            using result_of_memobj_t = typename result_of_memobj<MemPtr, Arg>::type;
+
+            template<typename MemPtr, typename Class, typename... Args>
+            struct result_of_memfun;
+
+            template<typename Func, typename Class, typename Arg, typename... Args>
+            struct result_of_memfun<Func Class::*, Arg, Args...>
+            {
+                using ArgVal = remove_reference_t<Arg>;
+                using MemPtr = Func Class::*;
+                using type = conditional_t<std::is_base_of<Class, ArgVal>::value,
+                    result_of_memfun_ref_t<MemPtr, Arg, Args...>,
+                    result_of_memfun_deref_t<MemPtr, Arg, Args...>>;
+            };
+
+            template<typename Func, typename Class, typename Arg, typename... Args>
+            using result_of_memfun_t = typename result_of_memfun<Func, Class, Arg, Args...>::type;
+
+            template<bool IsMemberObjectPointer, bool IsMemberFunctionPointer, 
+                typename Func, typename... Args>
+            struct result_of_impl
+            {
+                using type = failure_type;
+            };
+
+            template<typename MemPtr, typename Arg>
+            struct result_of_impl<true, false, MemPtr, Arg> : result_of_memobj<decay_t<MemPtr>, inv_unwrap_t<Arg>>
+            {};
+
+            template<typename MemPtr, typename Arg, typename... Args>
+            struct result_of_impl<false, true, MemPtr, Arg, Args...> : result_of_memfun<decay_t<MemPtr>, inv_unwrap_t<Arg>, Args...>
+            {};
+
+            template<typename Func, typename... Args>
+            struct result_of_impl<false, false, Func, Args...> : private result_of_func_impl
+            {
+                using type = decltype(test<Func, Args...>(0));
+            };
+
+            template<typename Func, typename... Args>
+            struct invoke_result : public result_of_impl<
+                std::is_member_object_pointer<remove_reference_t<Func>>::value,
+                std::is_member_function_pointer<remove_reference_t<Func>>::value,
+                Func, Args...>::type
+            {};
+
+            template<typename Func, typename... Args>
+            using invoke_result_t = typename invoke_result<Func, Args...>::type;
+
+            // Detect if a function type is invocable given a set of arguments.
+
+            // Primary template for invalid INVOKE expressions.
+            template<typename Result, typename R, bool = std::is_void<R>::value, typename = void>
+            struct is_invocable_impl : std::false_type
+            {};
+
+            // Valid INVOKE and INVOKE<void> expressions
+            template<typename Result, typename R>
+            struct is_invocable_impl<Result, R, true, void_t<typename Result::type>> : std::true_type
+            {};
+
+            // Valid INVOKE<R> expressions.
+            template<typename Result, typename R>
+            struct is_invocable_impl<Result, R, false, void_t<typename Result::type>>
+            {
+            private:
+                // The type of the INVOKE expression.
+                static typename Result::type get();
+
+                template<typename T>
+                static void conv(T);
+
+                // This overload is viable if INVOKE(f, args...) can convert to T
+                template<typename T, typename = decltype(conv<T>(get()))>
+                static std::true_type test(int);
+
+                // Fallback if failure
+                template<typename T>
+                static std::false_type test(...);
+
+            public:
+                using type = decltype(test<R>(0));
+            };
+
+            template<typename Func, typename... Args>
+            struct is_invocable : is_invocable_impl<invoke_result<Func, Args...>, void>::type
+            {};
+
+            template<typename R, typename Func, typename... Args>
+            struct is_invocable_r : is_invocable_impl<invoke_result<Func, Args...>, R>::type
+            {};
+
+            // Detect if invoking a function type with a set of arguments can't throw.
+            // Before C++17, noexcept is not part of the type of a function pointer,
+            // so only function objects and member functions called through
+            // a function object can be detected as nothrow.
+
+            // Primary template for invalid INVOKE expressions.
+            template<typename Tag, typename Func, typename... Args>
+            struct is_nothrow_invocable_impl : std::false_type
+            {};
+
+            template<typename Func, typename... Args>
+            struct is_nothrow_invocable_impl<invoke_func, Func, Args...>
+                : std::integral_constant<bool, noexcept(std::declval<Func>()(std::declval<Args>()...))>
+            {};
+
+            template<typename Func, typename T, typename... Args>
+            struct is_nothrow_invocable_impl<invoke_memfun_ref, Func, T, Args...>
+                : std::integral_constant<bool, noexcept((std::declval<inv_unwrap_t<T>>().*std::declval<Func>())(std::declval<Args>()...))>
+            {};
+
+            template<typename Func, typename T, typename... Args>
+            struct is_nothrow_invocable_impl<invoke_memfun_deref, Func, T, Args...>
+                : std::integral_constant<bool, noexcept(((*std::declval<T>()).*std::declval<Func>())(std::declval<Args>()...))>
+            {};
+
+            template<typename Func, typename T>
+            struct is_nothrow_invocable_impl<invoke_memobj_ref, Func, T> : std::true_type
+            {};
+
+            template<typename Func, typename T>
+            struct is_nothrow_invocable_impl<invoke_memobj_deref, Func, T>
+                : std::integral_constant<bool, noexcept(*std::declval<T>())>
+            {};
+
+            // The invoke tag of a valid INVOKE expression (or void).
+            template<typename Result, typename = void>
+            struct invoke_tag
+            {
+                using type = void;
+            };
+
+            template<typename Result>
+            struct invoke_tag<Result, void_t<typename Result::invoke_type>>
+            {
+                using type = typename Result::invoke_type;
+            };
+
+            template<typename Func, typename... Args>
+            struct is_nothrow_invocable
+                : is_nothrow_invocable_impl<typename invoke_tag<invoke_result<Func, Args...>>::type, Func, Args...>
+            {};
+#endif
+
+        } // namespace traits
+
+        // Use is_equality_compareable to try to perform the equality check
+        // (if it is valid for the given type).
+        template<typename T, bool = traits::is_equality_comparable<T>::value>
+        struct try_equals
+        {
+            static bool equals(const T& t1, const T& t2)
+            {
+                return t1 == t2;
+            }
+        };
+
+        // Partial specialization if type is not equality comparable.
+        // In this case, throw an exception to indicate that the type is not 
+        // equality comparable.
+        template<typename T>
+        struct try_equals<T, false>
+        {
+            static bool equals(const T&, const T&)
+            {
+                throw sig::not_comparable_exception();
+            }
+        };
+
+        // Copy a slot implementation. Function objects that can only be moved
+        // are supported until a copy of their slot is actually requested.
+        template<typename Impl>
+        Impl* clone_impl(const Impl& impl, std::true_type)
+        {
+            return new Impl(impl);
+        }
+
+        template<typename Impl>
+        Impl* clone_impl(const Impl&, std::false_type)
+        {
+            throw sig::not_copyable_exception();
+        }
+
+        template<typename Impl>
+        Impl* clone_impl(const Impl& impl)
+        {
+            return clone_impl(impl, std::is_copy_constructible<Impl>());
+        }
+
+        // Invoke a function object, pointer to member function, or pointer to
+        // member data and return the result as an optional value.
+        // The result of invoking a function that returns void is a disengaged optional.
+#if SIG_CPP17
+        template<typename R, typename Func, typename... Args>
+        opt::optional<R> invoke_slot(Func& f, Args&&... args)
+        {
+            if constexpr (std::is_void<R>::value)
+            {
+                std::invoke(f, std::forward<Args>(args)...);
+                return {};
+            }
+            else
+            {
+                return std::invoke(f, std::forward<Args>(args)...);
+            }
+        }
+#else
+        // Primary template
+        // Invokes a function object.
+        // @see https://en.cppreference.com/w/cpp/types/result_of
+        template<typename>
+        struct invoke_helper
+        {
+            // Call a function object.
+            template<typename Func, typename... Args>
+            static auto call(Func&& f, Args&&... args) -> decltype(std::forward<Func>(f)(std::forward<Args>(args)...))
+            {
+                return std::forward<Func>(f)(std::forward<Args>(args)...);
+            }
+        };
+
+        // Invoke a pointer to member function or pointer to member data.
+        // @see https://en.cppreference.com/w/cpp/types/result_of
+        template<typename Type, typename Base>
+        struct invoke_helper<Type Base::*>
+        {
+            // Get a reference type.
+            template<typename T, typename Td = traits::decay_t<T>,
+                typename = traits::enable_if_t<std::is_base_of<Base, Td>::value>>
+                static auto get(T&& t) -> T&&
+            {
+                return t;
+            }
+
+            // Get a std::reference_wrapper
+            template<typename T, typename Td = traits::decay_t<T>,
+                typename = traits::enable_if_t<traits::is_reference_wrapper<Td>::value>>
+                static auto get(T&& t) -> decltype(t.get())
+            {
+                return t.get();
+            }
+
+            // Get a pointer or pointer-like object (like smart_ptr, or unique_ptr)
+            template<typename T, typename Td = traits::decay_t<T>,
+                typename = traits::enable_if_t<!std::is_base_of<Base, Td>::value>,
+                typename = traits::enable_if_t<!traits::is_reference_wrapper<Td>::value>>
+                static auto get(T&& t) -> decltype(*std::forward<T>(t))
+            {
+                return *std::forward<T>(t);
+            }
+
+            // Call a pointer to a member function.
+            template<typename T, typename... Args, typename Type1,
+                typename = traits::enable_if_t<std::is_function<Type1>::value>>
+                static auto call(Type1 Base::* pmf, T&& t, Args&&... args)
+                -> decltype((get(std::forward<T>(t)).*pmf)(std::forward<Args>(args)...))
+            {
+                return (get(std::forward<T>(t)).*pmf)(std::forward<Args>(args)...);
+            }
+
+            // Call a pointer to member data.
+            template<typename T>
+            static auto call(Type Base::* pmd, T&& t)
+                -> decltype(get(std::forward<T>(t)).*pmd)
+            {
+                return get(std::forward<T>(t)).*pmd;
+            }
+        };
+
+        template<typename R, typename Func, typename... Args>
+        opt::optional<R> invoke_slot_impl(std::false_type, Func& f, Args&&... args)
+        {
+            return invoke_helper<Func>::call(f, std::forward<Args>(args)...);
+        }
+
+        template<typename R, typename Func, typename... Args>
+        opt::optional<R> invoke_slot_impl(std::true_type, Func& f, Args&&... args)
+        {
+            invoke_helper<Func>::call(f, std::forward<Args>(args)...);
+            return {};
+        }
+
+        template<typename R, typename Func, typename... Args>
+        opt::optional<R> invoke_slot(Func& f, Args&&... args)
+        {
+            return invoke_slot_impl<R>(std::is_void<R>(), f, std::forward<Args>(args)...);
+        }
+#endif
+
+        /**
+         * A copy-on-write template class to avoid unnecessary copies of
+         * data unless the data will be modified. This greatly improves
+         * the performance of the signal class in a multi-threaded environment
+         * since read-only copies only require a shared pointer copy.
+         * The copy-on-write pointer has similar semantics to shared pointers.
+         *
+         * @see API Design for C++, Martin Reddy (Elsevier, 2011).
+         */
+        template<typename T>
+        class cow_ptr
+        {
+        public:
+            using value_type = T;
+            using pointer_type = std::shared_ptr<T>;
+
+            constexpr cow_ptr() noexcept = default;
+            ~cow_ptr() = default;
+
+            constexpr explicit cow_ptr(T* other) noexcept
+                : m_Ptr(other)
+            {}
+
+            constexpr cow_ptr(const cow_ptr& other) noexcept
+                : m_Ptr(other.m_Ptr)
+            {}
+
+            constexpr cow_ptr(cow_ptr&& other) noexcept
+                : m_Ptr(std::move(other.m_Ptr))
+            {}
+
+            // Copy assignment operator.
+            cow_ptr& operator=(const cow_ptr& other) noexcept
+            {
+                if (this != &other)
+                {
+                    *this = cow_ptr(other);
+                }
+
+                return *this;
+            }
+
+            // Move assignment operator.
+            cow_ptr& operator=(cow_ptr&& other) noexcept
+            {
+                m_Ptr = std::move(other.m_Ptr);
+                return *this;
+            }
+
+            // Assign from other value.
+            cow_ptr& operator=(T* other) noexcept
+            {
+                m_Ptr = pointer_type(other);
+                return *this;
+            }
+
+            // Non-const dereference operator.
+            // Will create a copy of the underlying object.
+            T& operator*()
+            {
+                detach();
+                return *m_Ptr;
+            }
+
+            // Const dereference operator.
+            // No copy is made of the underlying object
+            const T& operator*() const noexcept
+            {
+                return *m_Ptr;
+            }
+
+            // Non-const pointer dereference operator.
+            // Will create a copy of the underlying object.
+            T* operator->()
+            {
+                detach();
+                return m_Ptr.get();
+            }
+
+            // Const pointer dereference operator.
+            // No copy is made of the underlying object.
+            const T* operator->() const
+            {
+                return m_Ptr.get();
+            }
+
+            // Non-const implicit conversion of underlying type.
+            // A copy will be created of the underlying object.
+            operator T* ()
+            {
+                detach();
+                return m_Ptr.get();
+            }
+
+            // Const implicit conversion of underlying type.
+            // No copy is made of the underlying object.
+            operator const T* () const
+            {
+                return m_Ptr.get();
+            }
+
+            T* data()
+            {
+                detach();
+                return m_Ptr.get();
+            }
+
+            const T* data() const
+            {
+                return m_Ptr.get();
+            }
+
+            // Get read-only reference to internal value.
+            const T& read() const
+            {
+                return *m_Ptr;
+            }
+
+            // Get writable reference to internal value.
+            T& write()
+            {
+                detach();
+                return *m_Ptr;
+            }
+
+            template<typename U>
+            bool operator==(const cow_ptr<U>& rhs) const noexcept
+            {
+                return m_Ptr == rhs.m_Ptr;
+            }
+
+            template<typename U>
+            bool operator!=(const cow_ptr<U>& rhs) const noexcept
+            {
+                return m_Ptr != rhs.m_Ptr;
+            }
+
+            // Explicit bool conversion to check for a valid
+            // internal value.
+            explicit operator bool() const noexcept
+            {
+                return bool(m_Ptr);
+            }
+
+        private:
+            // Returns true if other cow_ptr objects share the stored object.
+            // use_count() is a relaxed load, so if the object is not shared
+            // an acquire fence pairs with the release of the last other
+            // reference: the reads of copies that were just released happen
+            // before the stored object is modified in place.
+            bool shared() const noexcept
+            {
+                if (m_Ptr.use_count() != 1)
+                {
+                    return true;
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return false;
+            }
+
+            void detach()
+            {
+                if (m_Ptr && shared())
+                {
+#if SIG_SIGNAL_STATS
+                    if (auto counters = signal_counters::current())
+                    {
+                        counters->add(signal_counters::cow_copies, 1);
+                        counters->add(signal_counters::bytes_copied, cow_bytes(*m_Ptr));
+                    }
+#endif
+                    // Detach from the shared pointer
+                    // creating a new instance of the stored object.
+                    *this = cow_ptr(new T(*m_Ptr));
+                }
+            }
+
+            pointer_type m_Ptr;
+        };
+
+        // Utility function to create a cow_ptr.
+        template<typename T, typename... Args>
+        cow_ptr<T> make_cow(Args&&... args)
+        {
+            return cow_ptr<T>(new T(std::forward<Args>(args)...));
+        }
+
+        template<typename T, typename U, typename... Args>
+        cow_ptr<T> make_cow(std::initializer_list<U> il, Args&&... args)
+        {
+            return cow_ptr<T>(new T(il, std::forward<Args>(args)...));
+        }
+
+        /**
+         * A contiguous list that stores up to N elements inside the list object
+         * itself. Once more than N elements are added, the elements are moved
+         * to a copy-on-write heap vector (cow_ptr) and the list behaves exactly
+         * like a cow_ptr<std::vector<T>>. When the heap list shrinks to N / 2
+         * elements, the elements are moved back into the inline storage.
+         *
+         * Copying an inline list copies (at most N) elements, copying a heap
+         * list only copies the cow_ptr. In both cases the copy is a stable
+         * snapshot that is not affected by modifications to the original list.
+         *
+         * Element type T must be nothrow move constructible.
+         */
+        template<typename T, std::size_t N>
+        class slot_list
+        {
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using iterator = T*;
+            using const_iterator = const T*;
+            using heap_type = std::vector<T>;
+            using cow_type = cow_ptr<heap_type>;
+
+            static_assert(std::is_nothrow_move_constructible<T>::value, "slot_list requires a nothrow move constructible type.");
+
+            static constexpr size_type inline_capacity = N;
+
+            slot_list() noexcept
+                : m_Size(0)
+            {}
+
+            slot_list(const slot_list& other)
+                : m_Size(0)
+                , m_Heap(other.m_Heap)
+            {
+                if (is_inline())
+                {
+                    for (const auto& v : other)
+                    {
+                        ::new(inline_data() + m_Size) T(v);
+                        ++m_Size;
+                    }
+                }
+            }
+
+            slot_list(slot_list&& other) noexcept
+                : m_Size(0)
+                , m_Heap(std::move(other.m_Heap))
+            {
+                if (is_inline())
+                {
+                    move_inline(other);
+                }
+            }
+
+            ~slot_list()
+            {
+                destroy_inline();
+            }
+
+            slot_list& operator=(const slot_list& other)
+            {
+                if (this != &other)
+                {
+                    *this = slot_list(other);
+                }
+
+                return *this;
+            }
+
+            slot_list& operator=(slot_list&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    destroy_inline();
+                    m_Heap = std::move(other.m_Heap);
+                    if (is_inline())
+                    {
+                        move_inline(other);
+                    }
+                }
+
+                return *this;
+            }
+
+            // Returns true if the elements are stored inside the list object.
+            bool is_inline() const noexcept
+            {
+                return !static_cast<bool>(m_Heap);
+            }
+
+            size_type size() const noexcept
+            {
+                return is_inline() ? m_Size : m_Heap->size();
+            }
+
+            bool empty() const noexcept
+            {
+                return size() == 0;
+            }
+
+            // Read-only iteration never creates a copy of the heap list.
+            const_iterator begin() const noexcept
+            {
+                return is_inline() ? inline_data() : m_Heap->data();
+            }
+
+            const_iterator end() const noexcept
+            {
+                return begin() + size();
+            }
+
+            const T& operator[](size_type i) const
+            {
+                return begin()[i];
+            }
+
+            // Non-const element access.
+            // Will create a copy of the heap list if it is shared.
+            T& operator[](size_type i)
+            {
+                return data()[i];
+            }
+
+            T& back()
+            {
+                return data()[size() - 1];
+            }
+
+            // Non-const access to the underlying elements.
+            // Will create a copy of the heap list if it is shared.
+            T* data()
+            {
+                return is_inline() ? inline_data() : m_Heap.write().data();
+            }
+
+            void push_back(T&& value)
+            {
+                if (!is_inline())
+                {
+                    m_Heap.write().push_back(std::move(value));
+                }
+                else if (m_Size < N)
+                {
+                    ::new(inline_data() + m_Size) T(std::move(value));
+                    ++m_Size;
+                }
+                else
+                {
+                    // Spill the inline elements to the heap.
+                    auto heap = make_cow<heap_type>();
+                    auto& v = heap.write();
+                    v.reserve(N * 2 + 1);
+                    for (size_type i = 0; i < m_Size; ++i)
+                    {
+                        v.push_back(std::move(inline_data()[i]));
+                    }
+                    v.push_back(std::move(value));
+
+                    destroy_inline();
+                    m_Heap = std::move(heap);
+                }
+            }
+
+            // Insert an element before the element at index pos.
+            void insert(size_type pos, T&& value)
+            {
+                push_back(std::move(value));
+                auto d = data();
+                std::rotate(d + pos, d + size() - 1, d + size());
+            }
+
+            // Remove the element at index pos.
+            // The order of the remaining elements is preserved.
+            void erase(size_type pos)
+            {
+                auto d = data();
+                std::move(d + pos + 1, d + size(), d + pos);
+                pop_back();
+            }
+
+            // Remove all elements that satisfy the predicate, in one pass.
+            // The predicate is called once per element, in order, with the
+            // element and its index. The list isn't copied if no element is
+            // removed. The order of the remaining elements is preserved.
+            // @returns The number of elements that were removed.
+            template<typename Pred>
+            size_type erase_if(Pred pred)
+            {
+                const auto count = size();
+                size_type i = 0;
+                for (auto first = begin(); i < count && !pred(first[i], i); ++i)
+                {}
+
+                if (i == count)
+                {
+                    return 0;
+                }
+
+                auto d = data();
+                auto last = i;
+                for (++i; i < count; ++i)
+                {
+                    if (!pred(static_cast<const T&>(d[i]), i))
+                    {
+                        d[last++] = std::move(d[i]);
+                    }
+                }
+
+                while (size() > last)
+                {
+                    pop_back();
+                }
+                return count - last;
+            }
+
+            void pop_back()
+            {
+                if (!is_inline())
+                {
+                    m_Heap.write().pop_back();
+                    if (m_Heap.read().size() <= N / 2)
+                    {
+                        move_to_inline();
+                    }
+                }
+                else if (m_Size > 0)
+                {
+                    inline_data()[--m_Size].~T();
+                }
+            }
+
+            void clear()
+            {
+                destroy_inline();
+                m_Heap = cow_type();
+            }
+
+        private:
+            using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+            T* inline_data() noexcept
+            {
+                return reinterpret_cast<T*>(m_Inline);
+            }
+
+            const T* inline_data() const noexcept
+            {
+                return reinterpret_cast<const T*>(m_Inline);
+            }
+
+            void destroy_inline() noexcept
+            {
+                while (m_Size > 0)
+                {
+                    inline_data()[--m_Size].~T();
+                }
+            }
+
+            // Move the inline elements of another list into this (empty) list.
+            void move_inline(slot_list& other) noexcept
+            {
+                for (size_type i = 0; i < other.m_Size; ++i)
+                {
+                    ::new(inline_data() + i) T(std::move(other.inline_data()[i]));
+                }
+                m_Size = other.m_Size;
+                other.destroy_inline();
+            }
+
+            // Move the heap elements back into the inline storage.
+            // The heap list may still be shared with a snapshot in which case
+            // the elements are copied.
+            void move_to_inline()
+            {
+                const cow_type heap = std::move(m_Heap);
+                for (const auto& v : heap.read())
+                {
+                    ::new(inline_data() + m_Size) T(v);
+                    ++m_Size;
+                }
+            }
+
+            size_type m_Size;                   // Number of inline elements.
+            storage_type m_Inline[N > 0 ? N : 1];
+            cow_type m_Heap;                    // Heap storage when the list does not fit inline.
+        };
+
+        /**
+         * A persistent list that stores its elements in chunks of at most N
+         * elements. The chunks are referenced by a spine (an array of
+         * copy-on-write chunk pointers) which itself is copy-on-write.
+         *
+         * Copying a list only copies the pointer to the spine, so a copy is a
+         * stable snapshot like a copy of a slot_list. Modifying a list that
+         * shares its spine with a snapshot copies the spine (one pointer per
+         * chunk) and the affected chunk only, instead of all of the elements.
+         * Iterating the list is a linear scan over each chunk.
+         *
+         * Element type T must be nothrow move constructible.
+         */
+        template<typename T, std::size_t N>
+        class chunked_slot_list
+        {
+            using chunk_type = std::vector<T>;
+
+            struct chunk_entry
+            {
+                cow_ptr<chunk_type> chunk;
+                std::size_t end;            // The index after the last element of the chunk.
+            };
+
+            using spine_type = std::vector<chunk_entry>;
+
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+
+            static_assert(std::is_nothrow_move_constructible<T>::value, "chunked_slot_list requires a nothrow move constructible type.");
+            static_assert(N > 1, "The chunks of a chunked_slot_list must store at least 2 elements.");
+
+            static constexpr size_type chunk_capacity = N;
+
+            class const_iterator
+            {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+
+                const_iterator() noexcept
+                    : m_Chunk(nullptr)
+                    , m_Last(nullptr)
+                    , m_Elem(nullptr)
+                    , m_ChunkEnd(nullptr)
+                {}
+
+                reference operator*() const noexcept
+                {
+                    return *m_Elem;
+                }
+
+                pointer operator->() const noexcept
+                {
+                    return m_Elem;
+                }
+
+                const_iterator& operator++() noexcept
+                {
+                    if (++m_Elem == m_ChunkEnd)
+                    {
+                        // The chunks are never empty.
+                        if (++m_Chunk != m_Last)
+                        {
+                            set_chunk();
+                        }
+                        else
+                        {
+                            m_Elem = nullptr;
+                        }
+                    }
+                    return *this;
+                }
+
+                const_iterator operator++(int) noexcept
+                {
+                    const_iterator tmp(*this);
+                    ++*this;
+                    return tmp;
+                }
+
+                // The end iterator of all lists doesn't point to an element.
+                bool operator==(const const_iterator& other) const noexcept
+                {
+                    return m_Elem == other.m_Elem;
+                }
+
+                bool operator!=(const const_iterator& other) const noexcept
+                {
+                    return m_Elem != other.m_Elem;
+                }
+
+            private:
+                friend class chunked_slot_list;
+
+                const_iterator(const chunk_entry* first, const chunk_entry* last) noexcept
+                    : m_Chunk(first)
+                    , m_Last(last)
+                    , m_Elem(nullptr)
+                    , m_ChunkEnd(nullptr)
+                {
+                    if (first != last)
+                    {
+                        set_chunk();
+                    }
+                }
+
+                void set_chunk() noexcept
+                {
+                    const auto& chunk = m_Chunk->chunk.read();
+                    m_Elem = chunk.data();
+                    m_ChunkEnd = m_Elem + chunk.size();
+                }
+
+                const chunk_entry* m_Chunk;     // The current chunk.
+                const chunk_entry* m_Last;      // The end of the spine.
+                const T* m_Elem;                // The current element, or null at the end.
+                const T* m_ChunkEnd;            // The end of the current chunk.
+            };
+
+            chunked_slot_list() noexcept = default;
+
+            size_type size() const noexcept
+            {
+                return m_Spine ? m_Spine->back().end : 0;
+            }
+
+            bool empty() const noexcept
+            {
+                return !m_Spine;
+            }
+
+            // The number of chunks that store the elements.
+            size_type num_chunks() const noexcept
+            {
+                return m_Spine ? m_Spine->size() : 0;
+            }
+
+            // Read-only iteration never creates a copy of the spine or the chunks.
+            const_iterator begin() const noexcept
+            {
+                if (!m_Spine)
+                {
+                    return const_iterator();
+                }
+                const auto& spine = m_Spine.read();
+                return const_iterator(spine.data(), spine.data() + spine.size());
+            }
+
+            const_iterator end() const noexcept
+            {
+                return const_iterator();
+            }
+
+            const T& operator[](size_type i) const
+            {
+                const auto& spine = m_Spine.read();
+                const auto c = find_chunk(spine, i);
+                return spine[c].chunk.read()[i - chunk_begin(spine, c)];
+            }
+
+            // Non-const element access.
+            // Will create a copy of the spine and the chunk if they are shared.
+            T& operator[](size_type i)
+            {
+                auto& spine = m_Spine.write();
+                const auto c = find_chunk(spine, i);
+                return spine[c].chunk.write()[i - chunk_begin(spine, c)];
+            }
+
+            T& back()
+            {
+                return m_Spine.write().back().chunk.write().back();
+            }
+
+            void push_back(T&& value)
+            {
+                insert(size(), std::move(value));
+            }
+
+            // Insert an element before the element at index pos.
+            // Only the chunk that contains the element is modified. A full
+            // chunk is split in two, unless the element is appended to the
+            // list, in which case a new chunk is started.
+            void insert(size_type pos, T&& value)
+            {
+                const auto count = size();
+                if (!m_Spine)
+                {
+                    m_Spine = make_cow<spine_type>();
+                }
+
+                auto& spine = m_Spine.write();
+                if (spine.empty() || (pos == count && spine.back().chunk.read().size() == N))
+                {
+                    auto chunk = make_cow<chunk_type>();
+                    chunk.write().reserve(N);
+                    spine.push_back(chunk_entry{ std::move(chunk), count });
+                }
+
+                const auto c = pos == count ? spine.size() - 1 : find_chunk(spine, pos);
+                auto& chunk = spine[c].chunk.write();
+                chunk.insert(chunk.begin() + (pos - chunk_begin(spine, c)), std::move(value));
+
+                if (chunk.size() > N)
+                {
+                    // Move the second half of the chunk to a new chunk.
+                    auto next = make_cow<chunk_type>();
+                    auto& v = next.write();
+                    v.reserve(N);
+                    const auto half = chunk.size() / 2;
+                    std::move(chunk.begin() + half, chunk.end(), std::back_inserter(v));
+                    chunk.erase(chunk.begin() + half, chunk.end());
+                    spine.insert(spine.begin() + c + 1, chunk_entry{ std::move(next), 0 });
+                }
+
+                update_ends(spine, c);
+            }
+
+            // Remove the element at index pos.
+            // The order of the remaining elements is preserved. Empty chunks
+            // are removed and small neighboring chunks are merged.
+            void erase(size_type pos)
+            {
+                auto& spine = m_Spine.write();
+                auto c = find_chunk(spine, pos);
+                auto& chunk = spine[c].chunk.write();
+                chunk.erase(chunk.begin() + (pos - chunk_begin(spine, c)));
+
+                if (chunk.empty())
+                {
+                    spine.erase(spine.begin() + c);
+                    if (spine.empty())
+                    {
+                        m_Spine = cow_ptr<spine_type>();
+                        return;
+                    }
+                }
+                else if (c + 1 < spine.size() && chunk.size() + spine[c + 1].chunk.read().size() <= N / 2)
+                {
+                    const auto& next = spine[c + 1].chunk.read();
+                    chunk.insert(chunk.end(), next.begin(), next.end());
+                    spine.erase(spine.begin() + c + 1);
+                }
+
+                update_ends(spine, c);
+            }
+
+            // Remove all elements that satisfy the predicate, in one pass.
+            // The predicate is called once per element, in order, with the
+            // element and its index. Only the chunks that contain a removed
+            // element are copied and compacted, the elements of the other
+            // chunks are not moved. Empty chunks are removed and small
+            // neighboring chunks are merged.
+            // @returns The number of elements that were removed.
+            template<typename Pred>
+            size_type erase_if(Pred pred)
+            {
+                if (!m_Spine)
+                {
+                    return 0;
+                }
+
+                spine_type* spine = nullptr;    // Set when the first element is removed.
+                size_type index = 0;
+                size_type count = 0;
+                const auto num = m_Spine.read().size();
+                for (size_type c = 0; c < num; ++c)
+                {
+                    const auto& chunk = (spine ? *spine : m_Spine.read())[c].chunk.read();
+                    const auto n = chunk.size();
+                    size_type i = 0;
+                    for (; i < n && !pred(chunk[i], index + i); ++i)
+                    {}
+
+                    if (i < n)
+                    {
+                        if (!spine)
+                        {
+                            spine = &m_Spine.write();
+                        }
+
+                        auto& v = (*spine)[c].chunk.write();
+                        auto last = i;
+                        for (++i; i < n; ++i)
+                        {
+                            if (!pred(static_cast<const T&>(v[i]), index + i))
+                            {
+                                v[last++] = std::move(v[i]);
+                            }
+                        }
+                        count += n - last;
+                        v.erase(v.begin() + last, v.end());
+                    }
+                    index += n;
+                }
+
+                if (count > 0)
+                {
+                    compact(*spine);
+                    if (spine->empty())
+                    {
+                        m_Spine = cow_ptr<spine_type>();
+                    }
+                    else
+                    {
+                        update_ends(*spine, 0);
+                    }
+                }
+                return count;
+            }
+
+            void pop_back()
+            {
+                erase(size() - 1);
+            }
+
+            void clear()
+            {
+                m_Spine = cow_ptr<spine_type>();
+            }
+
+        private:
+            // Find the chunk that contains the element at index i.
+            static size_type find_chunk(const spine_type& spine, size_type i) noexcept
+            {
+                const auto iter = std::upper_bound(spine.begin(), spine.end(), i, [](size_type index, const chunk_entry& e)
+                {
+                    return index < e.end;
+                });
+                return static_cast<size_type>(iter - spine.begin());
+            }
+
+            static size_type chunk_begin(const spine_type& spine, size_type c) noexcept
+            {
+                return c == 0 ? 0 : spine[c - 1].end;
+            }
+
+            // Remove the empty chunks and merge small neighboring chunks.
+            static void compact(spine_type& spine)
+            {
+                size_type last = 0;
+                for (size_type c = 0; c < spine.size(); ++c)
+                {
+                    const auto& chunk = spine[c].chunk.read();
+                    if (chunk.empty())
+                    {
+                        continue;
+                    }
+
+                    if (last > 0 && spine[last - 1].chunk.read().size() + chunk.size() <= N / 2)
+                    {
+                        auto& prev = spine[last - 1].chunk.write();
+                        prev.insert(prev.end(), chunk.begin(), chunk.end());
+                        continue;
+                    }
+
+                    if (last != c)
+                    {
+                        spine[last] = std::move(spine[c]);
+                    }
+                    ++last;
+                }
+                spine.erase(spine.begin() + last, spine.end());
+            }
+
+            // Update the end indices of the chunks starting at chunk c.
+            static void update_ends(spine_type& spine, size_type c) noexcept
+            {
+                for (auto end = chunk_begin(spine, c); c < spine.size(); ++c)
+                {
+                    end += spine[c].chunk.read().size();
+                    spine[c].end = end;
+                }
+            }
+
+            cow_ptr<spine_type> m_Spine;    // Null if the list is empty.
+        };
+
+        class slot_base;
+
+        template<typename R, typename Func, typename... Args>
+        class slot_func_extended;
+
+#if SIG_SLOT_STATS
+        // Lock-free latency histogram of a slot.
+        // Counters are updated with relaxed atomics, so a snapshot that is taken
+        // while the slot is being invoked may be slightly inconsistent.
+        class slot_latency
+        {
+        public:
+            slot_latency() noexcept
+            {
+                reset();
+            }
+
+            // A copy of a slot starts with an empty histogram.
+            slot_latency(const slot_latency&) noexcept
+                : slot_latency()
+            {}
+
+            slot_latency& operator=(const slot_latency&) noexcept
+            {
+                return *this;
+            }
+
+            void record(std::uint64_t ns) noexcept
+            {
+                m_Buckets[latency_histogram::bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+                m_Count.fetch_add(1, std::memory_order_relaxed);
+                m_Total.fetch_add(ns, std::memory_order_relaxed);
+
+                auto max = m_Max.load(std::memory_order_relaxed);
+                while (ns > max && !m_Max.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+                {}
+            }
+
+            latency_histogram snapshot() const noexcept
+            {
+                latency_histogram h;
+                for (std::size_t i = 0; i < latency_histogram::num_buckets; ++i)
+                {
+                    h.m_Buckets[i] = m_Buckets[i].load(std::memory_order_relaxed);
+                }
+                h.m_Count = m_Count.load(std::memory_order_relaxed);
+                h.m_Total = m_Total.load(std::memory_order_relaxed);
+                h.m_Max = m_Max.load(std::memory_order_relaxed);
+                return h;
+            }
+
+            void reset() noexcept
+            {
+                for (auto& b : m_Buckets)
+                {
+                    b.store(0, std::memory_order_relaxed);
+                }
+                m_Count.store(0, std::memory_order_relaxed);
+                m_Total.store(0, std::memory_order_relaxed);
+                m_Max.store(0, std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<std::uint64_t> m_Buckets[latency_histogram::num_buckets];
+            std::atomic<std::uint64_t> m_Count;
+            std::atomic<std::uint64_t> m_Total;
+            std::atomic<std::uint64_t> m_Max;
+        };
+
+        // Records the time from construction to destruction in the latency histogram.
+        class latency_timer
+        {
+        public:
+            using clock_type = std::chrono::steady_clock;
+
+            explicit latency_timer(slot_latency& latency) noexcept
+                : m_Latency(latency)
+                , m_Start(clock_type::now())
+            {}
+
+            ~latency_timer()
+            {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_Start).count();
+                m_Latency.record(ns > 0 ? static_cast<std::uint64_t>(ns) : 0);
+            }
+
+        private:
+            slot_latency& m_Latency;
+            clock_type::time_point m_Start;
+        };
+#endif
+
+        /**
+         * Slot state is used as both a non-template base class for slot_impl
+         * as well as storing connection information about the slot.
+         */
+        class slot_state
+        {
+        public:
+            slot_state() noexcept
+                : m_Index(0)
+                , m_Connected(true)
+                , m_Blocked(false)
+            {}
+
+            // Atomic variables are not CopyConstructible.
+            // @see https://en.cppreference.com/w/cpp/atomic/atomic/atomic
+            slot_state(const slot_state& s) noexcept
+                : m_Index(s.m_Index)
+                , m_Connected(s.m_Connected.load())
+                , m_Blocked(s.m_Blocked.load())
+            {}
+
+            slot_state(slot_state&& s) noexcept
+                : m_Index(s.m_Index)
+                , m_Connected(s.m_Connected.load())
+                , m_Blocked(s.m_Blocked.load())
+            {}
+
+            virtual ~slot_state() = default;
+
+            slot_state& operator=(const slot_state& s) noexcept
+            {
+                m_Index = s.m_Index;
+                m_Connected = s.m_Connected.load();
+                m_Blocked = s.m_Blocked.load();
+
+                return *this;
+            }
+
+            slot_state& operator=(slot_state&& s) noexcept
+            {
+                m_Index = s.m_Index;
+                m_Connected.store(s.m_Connected.load());
+                m_Blocked.store(s.m_Blocked.load());
+
+                return *this;
+            }
+
+            virtual bool connected() const noexcept
+            {
+                return m_Connected;
+            }
+
+            bool disconnect() noexcept
+            {
+                return m_Connected.exchange(false);
+            }
+
+            bool blocked() const noexcept
+            {
+                return m_Blocked;
+            }
+
+            void block() noexcept
+            {
+                m_Blocked = true;
+            }
+
+            void unblock() noexcept
+            {
+                m_Blocked = false;
+            }
+
+            std::size_t& index()
+            {
+                return m_Index;
+            }
+
+#if SIG_SLOT_STATS
+            slot_latency& latency() noexcept
+            {
+                return m_Latency;
+            }
+
+            const slot_latency& latency() const noexcept
+            {
+                return m_Latency;
+            }
+#endif
+
+        private:
+            std::size_t m_Index;
+            std::atomic_bool m_Connected;
+            std::atomic_bool m_Blocked;
+#if SIG_SLOT_STATS
+            slot_latency m_Latency;
+#endif
+        };
+
+        // Base class for slot implementations.
+        template<typename R, typename... Args>
+        class slot_impl : public slot_state
+        {
+        public:
+            slot_impl() noexcept
+                : m_Filter(nullptr)
+            {}
+
+            virtual ~slot_impl() = default;
+            virtual slot_impl* clone() const = 0;
+            virtual bool equals(const slot_impl* s) const = 0;
+            virtual opt::optional<R> operator()(Args&&... args) = 0;
+
+            // Called by the slot that owns this implementation.
+            // Only extended slots need to know their owner.
+            virtual void bind(slot_base*) noexcept
+            {}
+
+            // True if invoking the slot can't throw. Signals count the slots
+            // that may throw (see signal::nothrow).
+            virtual bool nothrow() const noexcept
+            {
+                return false;
+            }
+
+            // Evaluate the filter of the slot (if any) before the slot is invoked.
+            // The filter is called through a function pointer instead of a
+            // virtual function so that rejecting the arguments is cheap.
+            bool filter(Args&... args) const
+            {
+                return !m_Filter || m_Filter(*this, args...);
+            }
+
+        protected:
+            using filter_type = bool (*)(const slot_impl&, Args&...);
+            filter_type m_Filter;
+        };
+
+        // Slot implementation for callable function objects (Functors)
+        template<typename R, typename Func, typename... Args>
+        class slot_func : public slot_impl<R, Args...>
+        {
+        public:
+            using fuction_type = traits::decay_t<Func>;
+
+            slot_func(const slot_func&) = default;  // Copy constructor.
+
+            slot_func(Func&& func)
+                : m_Func{ std::forward<Func>(func) }
+            {}
+
+            virtual slot_impl<R, Args...>* clone() const override
+            {
+                return clone_impl(*this);
+            }
+
+            virtual bool equals(const slot_impl<R, Args...>* s) const override
+            {
+                if (auto sfunc = dynamic_cast<const slot_func*>(s))
+                {
+                    return try_equals<fuction_type>::equals(m_Func, sfunc->m_Func);
+                }
+
+                return false;
+            }
+
+            // True if invoking the slot can't throw.
+            static constexpr bool is_nothrow = traits::is_nothrow_invocable<fuction_type&, Args...>::value;
+
+            virtual bool nothrow() const noexcept override
+            {
+                return is_nothrow;
+            }
+
+            virtual opt::optional<R> operator()(Args&&... args) override
+            {
+                return invoke_slot<R>(m_Func, std::forward<Args>(args)...);
+            }
+
+        private:
+            fuction_type m_Func;
+        };
+
+        // Slot implementation for pointer to member function and
+        // pointer to member data.
+        template<typename R, typename Func, typename Ptr, typename... Args>
+        class slot_pmf : public slot_impl<R, Args...>
+        {
+        public:
+            using function_type = traits::decay_t<Func>;
+            using pointer_type = traits::decay_t<Ptr>;
+
+            slot_pmf(const slot_pmf&) = default;
+
+            slot_pmf(Func&& func, Ptr&& ptr)
+                : m_Ptr{ std::forward<Ptr>(ptr) }
+                , m_Func{ std::forward<Func>(func) }
+            {}
+
+            virtual slot_impl<R, Args...>* clone() const override
+            {
+                return clone_impl(*this);
+            }
+
+            virtual bool equals(const slot_impl<R, Args...>* s) const override
+            {
+                if (auto spmf = dynamic_cast<const slot_pmf*>(s))
+                {
+                    return try_equals<pointer_type>::equals(m_Ptr, spmf->m_Ptr) &&
+                        try_equals<function_type>::equals(m_Func, spmf->m_Func);
+                }
+
+                return false;
+            }
+
+            // True if invoking the slot can't throw.
+            static constexpr bool is_nothrow = traits::is_nothrow_invocable<function_type&, pointer_type&, Args...>::value;
+
+            virtual bool nothrow() const noexcept override
+            {
+                return is_nothrow;
+            }
+
+            virtual opt::optional<R> operator()(Args&&... args) override
+            {
+                return invoke_slot<R>(m_Func, m_Ptr, std::forward<Args>(args)...);
+            }
+
+        private:
+            pointer_type m_Ptr;
+            function_type m_Func;
+        };
+
+        // Slot implementation for pointer to member function that automatically 
+        // tracks the lifetime of a supplied object through a weak pointer in 
+        // order to disconnect the slot on object destruction.
+        template<typename R, typename Func, typename WeakPtr, typename... Args>
+        class slot_pmf_tracked : public slot_impl<R, Args...>
+        {
+        public:
+            using function_type = traits::decay_t<Func>;
+            using pointer_type = traits::decay_t<WeakPtr>;
+
+            slot_pmf_tracked(const slot_pmf_tracked&) = default;
+
+            slot_pmf_tracked(Func&& func, WeakPtr&& ptr)
+                : m_Ptr{ std::forward<WeakPtr>(ptr) }
+                , m_Func{ std::forward<Func>(func) }
+            {}
+
+            virtual bool connected() const noexcept override
+            {
+                return !m_Ptr.expired() && slot_state::connected();
+            }
+
+            virtual slot_impl<R, Args...>* clone() const override
+            {
+                return clone_impl(*this);
+            }
+
+            virtual bool equals(const slot_impl<R, Args...>* s) const override
+            {
+                if (auto spmft = dynamic_cast<const slot_pmf_tracked*>(s))
+                {
+                    return try_equals<pointer_type>::equals(m_Ptr, spmft->m_Ptr) &&
+                        try_equals<function_type>::equals(m_Func, spmft->m_Func);
+                }
+
+                return false;
+            }
+
+            // True if invoking the slot can't throw.
+            static constexpr bool is_nothrow = traits::is_nothrow_invocable<function_type&, decltype(std::declval<pointer_type&>().lock())&, Args...>::value;
+
+            virtual bool nothrow() const noexcept override
+            {
+                return is_nothrow;
+            }
+
+            virtual opt::optional<R> operator()(Args&&... args) override
+            {
+                // If the object was destroyed, the slot is skipped and removed
+                // the next time a slot is connected to or disconnected from the signal.
+                auto sp = m_Ptr.lock();
+                if (!sp)
+                {
+                    return {};
+                }
+
+                if (this->connected())
+                {
+                    return invoke_slot<R>(m_Func, sp, std::forward<Args>(args)...);
+                }
+
+                return {};
+            }
+
+        private:
+            pointer_type m_Ptr;
+            function_type m_Func;
+        };
+
+        // Slot implementation for a function that is bound at compile time.
+        // The slot does not store the function so the function is called
+        // directly (and may be inlined).
+        template<typename R, typename FuncT, FuncT Func, typename... Args>
+        class slot_bound : public slot_impl<R, Args...>
+        {
+        public:
+            virtual slot_impl<R, Args...>* clone() const override
+            {
+                return new slot_bound(*this);
+            }
+
+            virtual bool equals(const slot_impl<R, Args...>* s) const override
+            {
+                return dynamic_cast<const slot_bound*>(s) != nullptr;
+            }
+
+            // True if invoking the slot can't throw.
+            static constexpr bool is_nothrow = traits::is_nothrow_invocable<FuncT, Args...>::value;
+
+            virtual bool nothrow() const noexcept override
+            {
+                return is_nothrow;
+            }
+
+            virtual opt::optional<R> operator()(Args&&... args) override
+            {
+                FuncT f = Func;
+                return invoke_slot<R>(f, std::forward<Args>(args)...);
+            }
+        };
+
+        // Slot implementation for a pointer to member function that is bound
+        // at compile time. Only the (decayed) object pointer is stored.
+        template<typename R, typename FuncT, FuncT Func, typename Ptr, typename... Args>
+        class slot_bound_pmf : public slot_impl<R, Args...>
+        {
+        public:
+            using pointer_type = Ptr;
+
+            slot_bound_pmf(const slot_bound_pmf&) = default;
+
+            explicit slot_bound_pmf(pointer_type ptr)
+                : m_Ptr{ std::move(ptr) }
+            {}
+
+            virtual slot_impl<R, Args...>* clone() const override
+            {
+                return new slot_bound_pmf(*this);
+            }
+
+            virtual bool equals(const slot_impl<R, Args...>* s) const override
+            {
+                if (auto sbound = dynamic_cast<const slot_bound_pmf*>(s))
+                {
+                    return try_equals<pointer_type>::equals(m_Ptr, sbound->m_Ptr);
+                }
+
+                return false;
+            }
+
+            // True if invoking the slot can't throw.
+            static constexpr bool is_nothrow = traits::is_nothrow_invocable<FuncT, pointer_type&, Args...>::value;
+
+            virtual bool nothrow() const noexcept override
+            {
+                return is_nothrow;
+            }
+
+            virtual opt::optional<R> operator()(Args&&... args) override
+            {
+                FuncT f = Func;
+                return invoke_slot<R>(f, m_Ptr, std::forward<Args>(args)...);
+            }
+
+        private:
+            pointer_type m_Ptr;
+        };
+
+        // Slot implementation for a pointer to member function that is bound
+        // at compile time and tracks the lifetime of the object through a
+        // weak pointer. Two slots are equal if they track the same object.
+        template<typename R, typename FuncT, FuncT Func, typename WeakPtr, typename... Args>
+        class slot_bound_pmf_tracked : public slot_impl<R, Args...>
+        {
+        public:
+            using pointer_type = WeakPtr;
+
+            slot_bound_pmf_tracked(const slot_bound_pmf_tracked&) = default;
+
+            explicit slot_bound_pmf_tracked(pointer_type ptr)
+                : m_Ptr{ std::move(ptr) }
+            {}
+
+            virtual bool connected() const noexcept override
+            {
+                return !m_Ptr.expired() && slot_state::connected();
+            }
+
+            virtual slot_impl<R, Args...>* clone() const override
+            {
+                return new slot_bound_pmf_tracked(*this);
+            }
+
+            virtual bool equals(const slot_impl<R, Args...>* s) const override
+            {
+                if (auto sbound = dynamic_cast<const slot_bound_pmf_tracked*>(s))
+                {
+                    return !m_Ptr.owner_before(sbound->m_Ptr) && !sbound->m_Ptr.owner_before(m_Ptr);
+                }
+
+                return false;
+            }
+
+            // True if invoking the slot can't throw.
+            static constexpr bool is_nothrow = traits::is_nothrow_invocable<FuncT, decltype(std::declval<pointer_type&>().lock())&, Args...>::value;
+
+            virtual bool nothrow() const noexcept override
+            {
+                return is_nothrow;
+            }
+
+            virtual opt::optional<R> operator()(Args&&... args) override
+            {
+                // If the object was destroyed, the slot is skipped and removed
+                // the next time a slot is connected to or disconnected from the signal.
+                auto sp = m_Ptr.lock();
+                if (!sp)
+                {
+                    return {};
+                }
+
+                FuncT f = Func;
+                return invoke_slot<R>(f, sp, std::forward<Args>(args)...);
+            }
+
+        private:
+            pointer_type m_Ptr;
+        };
+
+#if SIG_CPP17
+        // Integer sequence is used to unpack a tuple. This is required for the
+        // slot iterator.
+        using std::integer_sequence;
+        using std::index_sequence;
+        using std::make_index_sequence;
+        using std::index_sequence_for;
+#else
+        // since C++14
+        // @see https://en.cppreference.com/w/cpp/utility/integer_sequence
+        // @see https://gist.github.com/ntessore/dc17769676fb3c6daa1f
+        // Integer sequence is used to unpack a tuple. This is required for the 
+        // slot iterator.
+        template<typename T, T... Ints>
+        struct integer_sequence
+        {
+            using value_type = T;
+            static constexpr std::size_t size()
+            {
+                return sizeof...(Ints);
+            }
+        };
+
+        template<std::size_t... Ints>
+        using index_sequence = integer_sequence<std::size_t, Ints...>;
+
+        template<typename T, std::size_t N, T... Is>
+        struct make_integer_sequence : make_integer_sequence<T, N - 1, N - 1, Is...>
+        {};
+
+        // Specialization for integer sequences of 0 length.
+        template<typename T, T... Is>
+        struct make_integer_sequence<T, 0, Is...> : integer_sequence<T, Is...>
+        {};
+
+        template<std::size_t N>
+        using make_index_sequence = make_integer_sequence<std::size_t, N>;
+
+        template<typename... T>
+        using index_sequence_for = make_index_sequence<sizeof...(T)>;
+#endif
+
+        // The slot_iterator is a wrapper for the actual container that 
+        // contains a list of slots to be invoked. When the slot_iterator
+        // is dereferenced, it must invoke the slot that is referenced by the 
+        // current internal iterator and return the result of invoking the function.
+        //
+        // Iterator contract for combiners:
+        //   - A slot is only invoked when the iterator is dereferenced.
+        //     Incrementing or comparing the iterator never invokes a slot.
+        //   - Every dereference invokes the slot again (the result is not cached).
+        //   - A combiner may return before reaching last. Slots that have
+        //     not been dereferenced are not invoked.
+        //   - Blocked or disconnected slots return a disengaged optional.
+        template<typename T, typename InputIterator, typename... Args>
+        class slot_iterator
+        {
+        public:
+            // These are required for iterators:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::add_pointer<T>::type;
+            using reference = typename std::add_lvalue_reference<T>::type;
+
+            using args_type = std::tuple<Args...>;
+            using args_sequence = make_index_sequence<sizeof...(Args)>;
+
+            slot_iterator(InputIterator iter, args_type& args)
+                : m_Iter(iter)
+                , m_Args(args)
+            {}
+
+            slot_iterator(const slot_iterator&) = default;
+            slot_iterator(slot_iterator&&) = default;
+
+            // Pre-increment operator.
+            slot_iterator& operator++()
+            {
+                ++m_Iter;
+                return *this;
+            }
+
+            // Post-increment operator
+            slot_iterator operator++(int)
+            {
+                slot_iterator tmp(*this);
+                ++m_Iter;
+                return tmp;
+            }
+
+            bool operator==(const slot_iterator& other) const
+            {
+                return m_Iter == other.m_Iter;
+            }
+
+            bool operator!=(const slot_iterator& other) const
+            {
+                return m_Iter != other.m_Iter;
+            }
+
+            // Invoke the slot referenced by the internal iterator.
+            opt::optional<T> operator*()
+            {
+                return do_invoke(args_sequence());
+            }
+
+        private:
+            template<std::size_t... Is>
+            constexpr opt::optional<T> do_invoke(index_sequence<Is...>)
+            {
+                // Unpack tuple arguments and invoke slot.
+                return (**m_Iter)(std::forward<Args>(std::get<Is>(m_Args))...);
+            }
+
+            InputIterator m_Iter;
+            args_type& m_Args;
+        };
+
+        // Iterates two contiguous ranges as if they were a single range.
+        // Used by the keyed_signal to invoke the slots of a key followed
+        // by the wildcard slots without copying them into a single list.
+        template<typename T>
+        class concat_iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            // Iterator to the beginning of the first range.
+            concat_iterator(const T* first1, const T* last1, const T* first2)
+                : m_Iter(first1 != last1 ? first1 : first2)
+                , m_Last1(last1)
+                , m_First2(first2)
+            {}
+
+            // Iterator to the end of the second range.
+            explicit concat_iterator(const T* last2)
+                : m_Iter(last2)
+                , m_Last1(nullptr)
+                , m_First2(nullptr)
+            {}
+
+            // Pre-increment operator.
+            concat_iterator& operator++()
+            {
+                if (++m_Iter == m_Last1)
+                {
+                    m_Iter = m_First2;
+                }
+                return *this;
+            }
+
+            // Post-increment operator
+            concat_iterator operator++(int)
+            {
+                concat_iterator tmp(*this);
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(const concat_iterator& other) const
+            {
+                return m_Iter == other.m_Iter;
+            }
+
+            bool operator!=(const concat_iterator& other) const
+            {
+                return m_Iter != other.m_Iter;
+            }
+
+            const T& operator*() const
+            {
+                return *m_Iter;
+            }
+
+        private:
+            const T* m_Iter;
+            const T* m_Last1;
+            const T* m_First2;
+        };
+
+        // Iterates the elements of consecutive lists as if they were a single
+        // range. Used to invoke the slots of a signal followed by the slots of
+        // the signals that it forwards to without copying them into one list.
+        template<typename List>
+        class chain_iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = typename List::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+            // Iterator to the first element of the lists in [first, last).
+            chain_iterator(const List* first, const List* last)
+                : m_List(first)
+                , m_Last(last)
+            {
+                if (m_List != m_Last)
+                {
+                    m_Iter = m_List->begin();
+                    skip_empty();
+                }
+            }
+
+            // Iterator to the end of the lists that end at last.
+            explicit chain_iterator(const List* last)
+                : m_List(last)
+                , m_Last(last)
+            {}
+
+            // Pre-increment operator.
+            chain_iterator& operator++()
+            {
+                ++m_Iter;
+                skip_empty();
+                return *this;
+            }
+
+            // Post-increment operator
+            chain_iterator operator++(int)
+            {
+                chain_iterator tmp(*this);
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(const chain_iterator& other) const
+            {
+                return m_List == other.m_List && (m_List == m_Last || m_Iter == other.m_Iter);
+            }
+
+            bool operator!=(const chain_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            const value_type& operator*() const
+            {
+                return *m_Iter;
+            }
+
+        private:
+            // Move to the next list when the end of the current list is reached.
+            void skip_empty()
+            {
+                while (m_Iter == m_List->end())
+                {
+                    if (++m_List == m_Last)
+                    {
+                        return;
+                    }
+                    m_Iter = m_List->begin();
+                }
+            }
+
+            const List* m_List;
+            const List* m_Last;
+            typename List::const_iterator m_Iter;
+        };
+
+        // Iterates the stored results of the slots for a single argument set
+        // of a batch emission. The results are stored in slot-major order so
+        // the results for one argument set are stride elements apart.
+        template<typename T>
+        class result_iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const opt::optional<T>*;
+            using reference = const opt::optional<T>&;
+
+            result_iterator(const opt::optional<T>* first, std::size_t stride, std::size_t index)
+                : m_First(first)
+                , m_Stride(stride)
+                , m_Index(index)
+            {}
+
+            // Pre-increment operator.
+            result_iterator& operator++()
+            {
+                ++m_Index;
+                return *this;
+            }
+
+            // Post-increment operator
+            result_iterator operator++(int)
+            {
+                result_iterator tmp(*this);
+                ++m_Index;
+                return tmp;
+            }
+
+            bool operator==(const result_iterator& other) const
+            {
+                return m_Index == other.m_Index;
+            }
+
+            bool operator!=(const result_iterator& other) const
+            {
+                return m_Index != other.m_Index;
+            }
+
+            // The slot has already been invoked. Returns the stored result.
+            const opt::optional<T>& operator*() const
+            {
+                return m_First[m_Index * m_Stride];
+            }
+
+        private:
+            const opt::optional<T>* m_First;
+            std::size_t m_Stride;
+            std::size_t m_Index;
+        };
+
+        // Base type for slots.
+        // This is required for signal_base to be able to pass
+        // a slot to a signal through the signal_base interface.
+        class slot_base
+        {
+            // The signal class needs access to the index method.
+            template<typename, typename, typename>
+            friend class sig::signal;
+            template<typename, typename, typename, typename>
+            friend class sig::keyed_signal;
+            virtual std::size_t& index() = 0;
+
+        public:
+            virtual void block() = 0;
+            virtual void unblock() = 0;
+            virtual bool connected() const noexcept = 0;
+            virtual bool blocked() const noexcept = 0;
+            virtual bool disconnect() = 0;
+#if SIG_SLOT_STATS
+            virtual latency_histogram stats() const = 0;
+#endif
+        };
+
+        // Base type for the signal class.
+        // Allows slots to disconnect from a signal.
+        class signal_base
+        {
+        public:
+            virtual ~signal_base() = default;
+            virtual void remove_slot(slot_base& slot) = 0;
+
+            // Called while the signal is invoked when a slot finds that its
+            // tracked object was destroyed. Must not block or allocate.
+            virtual void slot_expired() noexcept {}
+        };
+
+        // Guards the forwarding relationships between all signals.
+        // Only used when forwarding is set up or torn down, never during emission.
+        inline std::mutex& forwarding_mutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+    } // namespace detail
+
+    /**
+     * A lightweight, non-owning handle to the connection of a slot.
+     * The connection handle is passed as the first argument to slots that
+     * are connected with signal::connect_extended so that a slot can manage
+     * its own connection (for example, to disconnect itself) without
+     * having to store a connection object.
+     * The connection handle is only valid during the invocation of the slot.
+     */
+    class connection_handle
+    {
+    public:
+        bool connected() const noexcept
+        {
+            return m_Slot->connected();
+        }
+
+        bool disconnect() noexcept
+        {
+            return m_Slot->disconnect();
+        }
+
+        bool blocked() const noexcept
+        {
+            return m_Slot->blocked();
+        }
+
+        void block() noexcept
+        {
+            m_Slot->block();
+        }
+
+        void unblock() noexcept
+        {
+            m_Slot->unblock();
+        }
+
+    private:
+        template<typename, typename, typename...>
+        friend class detail::slot_func_extended;
+
+        explicit connection_handle(detail::slot_base* s) noexcept
+            : m_Slot{ s }
+        {}
+
+        detail::slot_base* m_Slot;
+    };
+
+    namespace detail
+    {
+        // Slot implementation for extended slots.
+        // The function object receives a connection_handle to its own
+        // connection as the first argument.
+        template<typename R, typename Func, typename... Args>
+        class slot_func_extended : public slot_impl<R, Args...>
+        {
+        public:
+            using function_type = traits::decay_t<Func>;
+
+            slot_func_extended(const slot_func_extended&) = default;
+
+            slot_func_extended(Func&& func)
+                : m_Func{ std::forward<Func>(func) }
+                , m_Owner{ nullptr }
+            {}
+
+            virtual slot_impl<R, Args...>* clone() const override
+            {
+                return clone_impl(*this);
+            }
+
+            virtual bool equals(const slot_impl<R, Args...>* s) const override
+            {
+                if (auto sfunc = dynamic_cast<const slot_func_extended*>(s))
+                {
+                    return try_equals<function_type>::equals(m_Func, sfunc->m_Func);
+                }
+
+                return false;
+            }
+
+            // True if invoking the slot can't throw.
+            static constexpr bool is_nothrow = traits::is_nothrow_invocable<function_type&, connection_handle&, Args...>::value;
+
+            virtual bool nothrow() const noexcept override
+            {
+                return is_nothrow;
+            }
+
+            virtual opt::optional<R> operator()(Args&&... args) override
+            {
+                connection_handle c(m_Owner);
+                return invoke_slot<R>(m_Func, c, std::forward<Args>(args)...);
+            }
+
+            virtual void bind(slot_base* owner) noexcept override
+            {
+                m_Owner = owner;
+            }
+
+        private:
+            function_type m_Func;
+            slot_base* m_Owner;
+        };
+
+        // Slot implementation for callable function objects that are only
+        // invoked if the predicate returns true for the arguments.
+        template<typename R, typename Pred, typename Func, typename... Args>
+        class slot_filtered : public slot_func<R, Func, Args...>
+        {
+        public:
+            using base_type = slot_func<R, Func, Args...>;
+            using predicate_type = traits::decay_t<Pred>;
+
+            slot_filtered(const slot_filtered&) = default;
+
+            slot_filtered(Pred&& pred, Func&& func)
+                : base_type{ std::forward<Func>(func) }
+                , m_Pred{ std::forward<Pred>(pred) }
+            {
+                this->m_Filter = &slot_filtered::filter_args;
+            }
+
+            virtual slot_impl<R, Args...>* clone() const override
+            {
+                return clone_impl(*this);
+            }
+
+            // True if neither the predicate nor the function object can throw.
+            static constexpr bool is_nothrow = base_type::is_nothrow &&
+                traits::is_nothrow_invocable<const predicate_type&, Args&...>::value;
+
+            virtual bool nothrow() const noexcept override
+            {
+                return is_nothrow;
+            }
+
+        private:
+            static bool filter_args(const slot_impl<R, Args...>& s, Args&... args)
+            {
+                return static_cast<bool>(static_cast<const slot_filtered&>(s).m_Pred(args...));
+            }
+
+            predicate_type m_Pred;
+        };
+    } // namespace detail
+
+    // A predicate over the arguments of a signal that is used to filter
+    // the invocations of a slot. Use sig::filter to create a slot_filter.
+    template<typename Pred>
+    struct slot_filter
+    {
+        Pred pred;
+    };
+
+    // Create a filter for signal::connect.
+    // The slot is only invoked if the predicate returns true for the
+    // arguments of the signal. The predicate must be const callable.
+    template<typename Pred>
+    slot_filter<detail::traits::decay_t<Pred>> filter(Pred&& pred)
+    {
+        return { std::forward<Pred>(pred) };
+    }
+
+    // A non-owning reference to a callable object. Use sig::ref to create a slot_ref.
+    // A slot that is connected with a slot_ref stores only the address of the
+    // callable object, so the object is never copied (not even when the slot
+    // is copied). Two slot_refs are equal if they refer to the same object.
+    // The callable object must outlive the connection.
+    template<typename Func>
+    struct slot_ref
+    {
+        Func* func;
+
+        template<typename... Args>
+        auto operator()(Args&&... args) const noexcept(noexcept((*func)(std::forward<Args>(args)...)))
+            -> decltype((*func)(std::forward<Args>(args)...))
+        {
+            return (*func)(std::forward<Args>(args)...);
+        }
+
+        friend bool operator==(const slot_ref& lhs, const slot_ref& rhs) noexcept
+        {
+            return lhs.func == rhs.func;
+        }
+
+        friend bool operator!=(const slot_ref& lhs, const slot_ref& rhs) noexcept
+        {
+            return lhs.func != rhs.func;
+        }
+    };
+
+    // Create a reference to a callable object for signal::connect and
+    // signal::disconnect.
+    template<typename Func>
+    slot_ref<Func> ref(Func& func) noexcept
+    {
+        return { std::addressof(func) };
+    }
+
+    // A reference to a temporary would dangle.
+    template<typename Func>
+    void ref(const Func&&) = delete;
+
+    namespace detail
+    {
+        // Deletes the implementation of a slot, unless the implementation
+        // is stored in the same allocation as the slot (see slot_node).
+        template<typename T>
+        struct slot_impl_deleter
+        {
+            slot_impl_deleter() noexcept = default;
+
+            explicit slot_impl_deleter(bool owns) noexcept
+                : owner(owns)
+            {}
+
+            void operator()(T* p) const noexcept
+            {
+                if (owner)
+                    delete p;
+            }
+
+            bool owner = true;
+        };
+
+        template<typename Impl, typename Slot>
+        struct slot_node;
+    } // namespace detail
+
+    // Primary slot template
+    template<typename Func>
+    class slot;
+
+    // TODO: Refactor slot to derive from detail::slot_state
+    // Specialization for function objects.
+    template<typename R, typename... Args>
+    class slot<R(Args...)> : public detail::slot_base
+    {
+        using impl = detail::slot_impl<R, Args...>;
+        using impl_ptr = std::unique_ptr<impl, detail::slot_impl_deleter<impl>>;
+
+    public:
+        // Default constructor.
+        constexpr slot() noexcept
+            : m_pImpl{ nullptr }
+            , m_pSignal{ nullptr }
+        {}
+
+        // Slot that takes a function object.
+        template<typename Func>
+        slot(Func&& func, detail::signal_base* signal = nullptr)
+            : m_pImpl{ new detail::slot_func<R, Func, Args...>(std::forward<Func>(func)) }
+            , m_pSignal{ signal }
+        {
+            bind();
+        }
+
+        // Slot that takes a pointer to member function or pointer to member data.
+        template<typename Func, typename Ptr>
+        slot(Func&& func, Ptr&& ptr, detail::signal_base* signal = nullptr,
+            detail::traits::enable_if_t<!detail::traits::is_weak_ptr_convertable<Ptr>::value, void*> = nullptr)
+            : m_pImpl{ new detail::slot_pmf<R, Func, Ptr, Args...>(std::forward<Func>(func), std::forward<Ptr>(ptr)) }
+            , m_pSignal{ signal }
+        {
+            bind();
+        }
+
+        template<typename Func, typename Ptr>
+        slot(Func&& func, Ptr&& ptr, detail::signal_base* signal = nullptr,
+            detail::traits::enable_if_t<detail::traits::is_weak_ptr_convertable<Ptr>::value, void*> = nullptr)
+            : m_pImpl{ new detail::slot_pmf_tracked<R, Func, decltype(to_weak(std::forward<Ptr>(ptr))), Args...>(std::forward<Func>(func), to_weak(std::forward<Ptr>(ptr))) }
+            , m_pSignal{ signal }
+        {
+            bind();
+        }
+
+        // Copy constructor.
+        slot(const slot& copy, detail::signal_base* signal = nullptr)
+            : m_pImpl{ copy.m_pImpl->clone() }
+            , m_pSignal{ signal ? signal : copy.m_pSignal }
+        {
+            bind();
+        }
+
+        // Explicit parameterized constructor.
+        explicit slot(std::unique_ptr<impl> pImpl, detail::signal_base* signal = nullptr)
+            : m_pImpl{ pImpl.release() }
+            , m_pSignal{ signal }
+        {
+            bind();
+        }
+
+        // Move constructor.
+        slot(slot&& other)
+            : m_pImpl{ std::move(other.m_pImpl) }
+            , m_pSignal{ other.m_pSignal }
+        {
+            other.m_pSignal = nullptr;
+            bind();
+        }
+
+        // Assignment operator.
+        slot& operator=(const slot& other)
+        {
+            if (&other != this)
+            {
+                m_pImpl = impl_ptr(other.m_pImpl ? other.m_pImpl->clone() : nullptr);
+                m_pSignal = other.m_pSignal;
+                bind();
+            }
+            return *this;
+        }
+
+        // Move assignment operator.
+        slot& operator=(slot&& other) noexcept
+        {
+            m_pImpl = std::move(other.m_pImpl);
+            m_pSignal = other.m_pSignal;
+            other.m_pSignal = nullptr;
+            bind();
+
+            return *this;
+        }
+
+        // Explicit conversion to bool.
+        explicit operator bool() const
+        {
+            return m_pImpl != nullptr;
+        }
+
+        // Equality operator
+        friend bool operator==(const slot& s1, const slot& s2)
+        {
+            if (!s1 || !s2)
+            {
+                return !s1 && !s2;
+            }
+
+            return s1.m_pImpl->equals(s2.m_pImpl.get());
+        }
+
+        // Inequality operator
+        friend bool operator!=(const slot& s1, const slot& s2)
+        {
+            return !(s1 == s2);
+        }
+
+        bool connected() const noexcept
+        {
+            return m_pImpl && m_pImpl->connected();
+        }
+
+        bool disconnect() noexcept
+        {
+            if (m_pImpl && m_pSignal && m_pImpl->disconnect() )
+            {
+                m_pSignal->remove_slot(*this);
+                return true;
+            }
+
+            return false;
+        }
+
+        bool blocked() const noexcept
+        {
+            return m_pImpl && m_pImpl->blocked();
+        }
+
+        void block() noexcept
+        {
+            if (m_pImpl)
+                m_pImpl->block();
+        }
+
+        void unblock() noexcept
+        {
+            if (m_pImpl)
+                m_pImpl->unblock();
+        }
+
+        // Invoke the slot.
+        opt::optional<R> operator()(Args&&... args)
+        {
+            if (!blocked() && connected() && m_pImpl->filter(args...))
+            {
+#if SIG_SLOT_STATS
+                detail::latency_timer timer(m_pImpl->latency());
+#endif
+#if SIG_TRACE
+                detail::trace_scope trace("slot", "slot", this);
+#endif
+                return (*m_pImpl)(std::forward<Args>(args)...);
+            }
+
+            // Let the signal remove a slot whose tracked object was destroyed
+            // the next time its slots are modified. A slot that was already
+            // disconnected doesn't refer to its signal, which may be gone.
+            if (m_pImpl && m_pSignal && !m_pImpl->connected() && m_pImpl->disconnect())
+            {
+                m_pSignal->slot_expired();
+            }
+
+            return {};
+        }
+
+#if SIG_SLOT_STATS
+        // The latency histogram of the slot.
+        latency_histogram stats() const noexcept override
+        {
+            return m_pImpl ? m_pImpl->latency().snapshot() : latency_histogram();
+        }
+#endif
+
+    private:
+        // Signals need to access the state of the slots.
+        template<typename, typename, typename>
+        friend class signal;
+        template<typename, typename, typename, typename>
+        friend class keyed_signal;
+        template<typename, typename>
+        friend struct detail::slot_node;
+
+        // Create a slot and its implementation in a single allocation.
+        // If RequireNothrow is true, invoking the slot must not throw.
+        template<typename Impl, bool RequireNothrow = false, typename... ImplArgs>
+        static std::shared_ptr<slot> make(detail::signal_base* signal, ImplArgs&&... args)
+        {
+            static_assert(!RequireNothrow || Impl::is_nothrow,
+                "The slots of a nothrow_signal must be noexcept");
+
+            auto node = std::make_shared<detail::slot_node<Impl, slot>>(signal, std::forward<ImplArgs>(args)...);
+            return std::shared_ptr<slot>(node, &node->slot);
+        }
+
+        // Create a slot for a function object.
+        template<bool RequireNothrow = false, typename Func>
+        static std::shared_ptr<slot> make_func(detail::signal_base* signal, Func&& func)
+        {
+            return make<detail::slot_func<R, Func, Args...>, RequireNothrow>(signal, std::forward<Func>(func));
+        }
+
+        // Create a slot for a pointer to member function or pointer to member data.
+        template<bool RequireNothrow = false, typename Func, typename Ptr>
+        static detail::traits::enable_if_t<!detail::traits::is_weak_ptr_convertable<Ptr>::value, std::shared_ptr<slot>>
+        make_func(detail::signal_base* signal, Func&& func, Ptr&& ptr)
+        {
+            return make<detail::slot_pmf<R, Func, Ptr, Args...>, RequireNothrow>(signal, std::forward<Func>(func), std::forward<Ptr>(ptr));
+        }
+
+        // Create a slot for a pointer to member function that tracks the object.
+        template<bool RequireNothrow = false, typename Func, typename Ptr>
+        static detail::traits::enable_if_t<detail::traits::is_weak_ptr_convertable<Ptr>::value, std::shared_ptr<slot>>
+        make_func(detail::signal_base* signal, Func&& func, Ptr&& ptr)
+        {
+            using weak_type = decltype(to_weak(std::forward<Ptr>(ptr)));
+            return make<detail::slot_pmf_tracked<R, Func, weak_type, Args...>, RequireNothrow>(signal, std::forward<Func>(func), to_weak(std::forward<Ptr>(ptr)));
+        }
+
+        // Slot that doesn't own its implementation.
+        slot(impl& embedded, detail::signal_base* signal) noexcept
+            : m_pImpl{ &embedded, detail::slot_impl_deleter<impl>(false) }
+            , m_pSignal{ signal }
+        {
+            bind();
+        }
+
+        virtual std::size_t& index() override
+        {
+            return m_pImpl->index();
+        }
+
+        // Let the implementation know which slot owns it.
+        void bind() noexcept
+        {
+            if (m_pImpl)
+                m_pImpl->bind(this);
+        }
+
+        // Query the state of the slot.
+        constexpr detail::slot_state& state()
+        {
+            return *m_pImpl;
+        }
+
+        impl_ptr m_pImpl;                           // Pointer to implementation
+        detail::signal_base* m_pSignal;             // The signal this slot belongs to.
+    };
+
+    namespace detail
+    {
+        // A slot and its implementation in a single allocation.
+        // The slot is only accessed through a shared pointer that aliases
+        // the node, so it is never copied or moved out of the node.
+        template<typename Impl, typename Slot>
+        struct slot_node
+        {
+            template<typename... ImplArgs>
+            explicit slot_node(signal_base* signal, ImplArgs&&... args)
+                : impl(std::forward<ImplArgs>(args)...)
+                , slot(static_cast<typename Slot::impl&>(impl), signal)  // Not the function object constructor.
+            {}
+
+            Impl impl;
+            Slot slot;
+        };
+    } // namespace detail
+
+    // Shared pointer to a slot.
+    using slot_ptr = std::shared_ptr<detail::slot_base>;
+
+    // Weak pointer to a slot.
+    using slot_wptr = std::weak_ptr<detail::slot_base>;
+
+    /**
+     * An RAII object that blocks connections until destruction.
+     */
+    class connection_blocker
+    {
+    public:
+        using slot_type = slot_wptr;
+
+        connection_blocker() noexcept = default;
+        ~connection_blocker() noexcept
+        {
+            release();
+        }
+
+        connection_blocker(const connection_blocker&) noexcept = delete;
+        connection_blocker(connection_blocker&& c) noexcept
+            : m_Slot{ std::move(c.m_Slot) }
+        {}
+
+        connection_blocker& operator=(const connection_blocker&) = delete;
+        connection_blocker& operator=(connection_blocker&& c) noexcept
+        {
+            release();
+            m_Slot = std::move(c.m_Slot);
+            return *this;
+        }
+
+        void swap(connection_blocker& other) noexcept
+        {
+            std::swap(m_Slot, other.m_Slot);
+        }
+
+    private:
+        friend class connection;
+
+        explicit connection_blocker(slot_type slot) noexcept
+            : m_Slot{ std::move(slot) }
+        {
+            if (auto s = m_Slot.lock())
+            {
+                s->block();
+            }
+        }
+
+        void release() noexcept
+        {
+            if (auto s = m_Slot.lock())
+            {
+                s->unblock();
+            }
+        }
+
+        slot_type m_Slot;
+    };
+
+    inline void swap(connection_blocker& cb1, connection_blocker& cb2) noexcept
+    {
+        cb1.swap(cb2);
+    }
+
+    /**
+     * Connection object allows for managing slot connections.
+     */
+    class connection
+    {
+    public:
+        using slot_type = slot_wptr;
+
+        connection() noexcept = default;
+        virtual ~connection() = default;
+
+        connection(const connection&) noexcept = default;
+        connection(connection&&) noexcept = default;
+        connection& operator=(const connection&) noexcept = default;
+        connection& operator=(connection&&) noexcept = default;
+
+        bool valid() const noexcept
+        {
+            return !m_Slot.expired();
+        }
+
+        bool connected() const noexcept
         {
-        public:
-            using value_type = T;
-            using pointer_type = std::shared_ptr<T>;
+            const auto s = m_Slot.lock();
+            return s && s->connected();
+        }
 
-            constexpr cow_ptr() noexcept = default;
-            ~cow_ptr() = default;
+        bool disconnect() noexcept
+        {
+            auto s = m_Slot.lock();
+            return s && s->disconnect();
+        }
 
-            constexpr explicit cow_ptr(T* other) noexcept
-                : m_Ptr(other)
-            {}
+        bool blocked() const noexcept
+        {
+            const auto s = m_Slot.lock();
+            return s && s->blocked();
+        }
 
-            constexpr cow_ptr(const cow_ptr& other) noexcept
-                : m_Ptr(other.m_Ptr)
-            {}
+        void block() noexcept
+        {
+            if (auto s = m_Slot.lock())
+            {
+                s->block();
+            }
+        }
 
-            constexpr cow_ptr(cow_ptr&& other) noexcept
-                : m_Ptr(std::move(other.m_Ptr))
-            {}
+        void unblock() noexcept
+        {
+            if (auto s = m_Slot.lock())
+            {
+                s->unblock();
+            }
+        }
 
-            // Copy assignment operator.
-            cow_ptr& operator=(const cow_ptr& other) noexcept
+        connection_blocker blocker() const noexcept
+        {
+            return connection_blocker(m_Slot);
+        }
+
+#if SIG_SLOT_STATS
+        // The latency histogram of the slot.
+        // Returns an empty histogram if the slot no longer exists.
+        latency_histogram stats() const noexcept
+        {
+            const auto s = m_Slot.lock();
+            return s ? s->stats() : latency_histogram();
+        }
+#endif
+
+        void swap(connection& other) noexcept
+        {
+            std::swap(m_Slot, other.m_Slot);
+        }
+
+    protected:
+        template<typename, typename, typename>
+        friend class signal;
+        template<typename, typename, typename, typename>
+        friend class keyed_signal;
+
+        friend class scoped_connection;
+
+        explicit connection(slot_type&& s) noexcept
+            : m_Slot{ std::move(s) }
+        {}
+
+        slot_type m_Slot;
+    };
+
+    inline void swap(connection& c1, connection& c2)
+    {
+        c1.swap(c2);
+    }
+    
+
+    /**
+     * An RAII version of connection which disconnects it's slot on destruction.
+     */
+    class scoped_connection : public connection
+    {
+    public:
+        using base = connection;
+        using slot_type = slot_wptr;
+
+        scoped_connection() = default;
+        virtual ~scoped_connection() override
+        {
+            this->disconnect();
+        }
+
+        scoped_connection(const base& c) noexcept
+            : base(c)
+        {}
+
+        scoped_connection(base&& c) noexcept
+            : base(std::move(c))
+        {}
+
+        scoped_connection(const scoped_connection&) noexcept = delete;
+
+        scoped_connection(scoped_connection&& s) noexcept
+            : base(std::move(s.m_Slot))
+        {}
+
+        scoped_connection& operator=(const scoped_connection&) noexcept = delete;
+
+        scoped_connection& operator=(scoped_connection&& c) noexcept
+        {
+            this->disconnect();
+            this->m_Slot = std::move(c.m_Slot);
+            return *this;
+        }
+
+        connection release()
+        {
+            return connection(std::move(this->m_Slot));
+        }
+
+    private:
+        explicit scoped_connection(slot_type s) noexcept
+            : base(std::move(s))
+        {}
+    };
+
+    inline void swap(scoped_connection& c1, scoped_connection& c2)
+    {
+        c1.swap(c2);
+    }
+
+    // Default combiner for signals returns an optional value.
+    // The combiner just returns the result of the last connected slot.
+    // If no slots or functions returns void, a disengaged optional is returned.
+    template<typename T>
+    class optional_last_value
+    {
+    public:
+        using result_type = opt::optional<T>;
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            result_type result;
+            while (first != last)
             {
-                if (this != &other)
-                {
-                    *this = cow_ptr(other);
-                }
+                result_type temp = *first;
+                if (temp)   // Skip disengaged results.
+                    result = temp;
+                ++first;
+            }
 
-                return *this;
+            return result;
+        }
+    };
+
+    // Combiner that returns the result of the first slot that returns an
+    // engaged value. The remaining slots are not invoked.
+    // If no slot returns an engaged value, a disengaged optional is returned.
+    template<typename T>
+    class first_engaged
+    {
+    public:
+        using result_type = opt::optional<T>;
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            for (; first != last; ++first)
+            {
+                result_type temp = *first;
+                if (temp)
+                    return temp;
             }
 
-            // Move assignment operator.
-            cow_ptr& operator=(cow_ptr&& other) noexcept
+            return {};
+        }
+    };
+
+    // Combiner that returns the first engaged result that satisfies the predicate.
+    // The remaining slots are not invoked.
+    // If no result satisfies the predicate, a disengaged optional is returned.
+    template<typename T, typename Pred>
+    class first_that
+    {
+    public:
+        using result_type = opt::optional<T>;
+
+        explicit first_that(Pred pred = Pred())
+            : m_Pred(std::move(pred))
+        {}
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            for (; first != last; ++first)
             {
-                m_Ptr = std::move(other.m_Ptr);
-                return *this;
+                result_type temp = *first;
+                if (temp && m_Pred(*temp))
+                    return temp;
             }
 
-            // Assign from other value.
-            cow_ptr& operator=(T* other) noexcept
+            return {};
+        }
+
+    private:
+        Pred m_Pred;
+    };
+
+    // Combiner that returns true if any slot returns a value that converts to true.
+    // The remaining slots are not invoked after the first true result.
+    // Disengaged results are ignored. Returns false if no slots are connected.
+    class any_of
+    {
+    public:
+        using result_type = bool;
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            for (; first != last; ++first)
             {
-                m_Ptr = pointer_type(other);
-                return *this;
+                auto temp = *first;
+                if (temp && static_cast<bool>(*temp))
+                    return true;
             }
 
-            // Non-const dereference operator.
-            // Will create a copy of the underlying object.
-            T& operator*()
+            return false;
+        }
+    };
+
+    // Combiner that returns true if all slots return a value that converts to true.
+    // The remaining slots are not invoked after the first false result.
+    // Disengaged results are ignored. Returns true if no slots are connected.
+    class all_of
+    {
+    public:
+        using result_type = bool;
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            for (; first != last; ++first)
             {
-                detach();
-                return *m_Ptr;
+                auto temp = *first;
+                if (temp && !static_cast<bool>(*temp))
+                    return false;
             }
 
-            // Const dereference operator.
-            // No copy is made of the underlying object
-            const T& operator*() const noexcept
+            return true;
+        }
+    };
+
+    namespace detail
+    {
+        // A growable buffer of trivially copyable values whose storage is
+        // aligned for SIMD loads. Copying a buffer does not copy its contents.
+        template<typename T, std::size_t Alignment = 32>
+        class aligned_buffer
+        {
+        public:
+            static_assert(std::is_trivially_copyable<T>::value, "aligned_buffer requires a trivially copyable type.");
+
+            aligned_buffer() noexcept
+                : m_Data(nullptr)
+                , m_Size(0)
+                , m_Capacity(0)
+            {}
+
+            aligned_buffer(const aligned_buffer&) noexcept
+                : aligned_buffer()
+            {}
+
+            aligned_buffer(aligned_buffer&& other) noexcept
+                : m_Storage(std::move(other.m_Storage))
+                , m_Data(other.m_Data)
+                , m_Size(other.m_Size)
+                , m_Capacity(other.m_Capacity)
             {
-                return *m_Ptr;
+                other.m_Data = nullptr;
+                other.m_Size = 0;
+                other.m_Capacity = 0;
             }
 
-            // Non-const pointer dereference operator.
-            // Will create a copy of the underlying object.
-            T* operator->()
+            aligned_buffer& operator=(const aligned_buffer&) noexcept
             {
-                detach();
-                return m_Ptr.get();
+                clear();
+                return *this;
             }
 
-            // Const pointer dereference operator.
-            // No copy is made of the underlying object.
-            const T* operator->() const
+            aligned_buffer& operator=(aligned_buffer&& other) noexcept
             {
-                return m_Ptr.get();
+                m_Storage = std::move(other.m_Storage);
+                m_Data = other.m_Data;
+                m_Size = other.m_Size;
+                m_Capacity = other.m_Capacity;
+                other.m_Data = nullptr;
+                other.m_Size = 0;
+                other.m_Capacity = 0;
+                return *this;
             }
 
-            // Non-const implicit conversion of underlying type.
-            // A copy will be created of the underlying object.
-            operator T* ()
+            const T* data() const noexcept
             {
-                detach();
-                return m_Ptr.get();
+                return m_Data;
             }
 
-            // Const implicit conversion of underlying type.
-            // No copy is made of the underlying object.
-            operator const T* () const
+            std::size_t size() const noexcept
+            {
+                return m_Size;
+            }
+
+            std::size_t capacity() const noexcept
             {
-                return m_Ptr.get();
+                return m_Capacity;
             }
 
-            T* data()
+            bool empty() const noexcept
             {
-                detach();
-                return m_Ptr.get();
+                return m_Size == 0;
             }
 
-            const T* data() const
+            void clear() noexcept
             {
-                return m_Ptr.get();
+                m_Size = 0;
             }
 
-            // Get read-only reference to internal value.
-            const T& read() const
+            void push_back(T value)
             {
-                return *m_Ptr;
+                if (m_Size == m_Capacity)
+                {
+                    reserve(m_Capacity > 0 ? m_Capacity * 2 : 16);
+                }
+                m_Data[m_Size++] = value;
             }
 
-            // Get writable reference to internal value.
-            T& write()
+            void reserve(std::size_t capacity)
             {
-                detach();
-                return *m_Ptr;
+                if (capacity <= m_Capacity) return;
+
+                std::size_t space = capacity * sizeof(T) + Alignment - 1;
+                std::unique_ptr<unsigned char[]> storage(new unsigned char[space]);
+                void* p = storage.get();
+                T* data = static_cast<T*>(std::align(Alignment, capacity * sizeof(T), p, space));
+                std::copy(m_Data, m_Data + m_Size, data);
+
+                m_Storage = std::move(storage);
+                m_Data = data;
+                m_Capacity = capacity;
             }
 
-            template<typename U>
-            bool operator==(const cow_ptr<U>& rhs) const noexcept
+        private:
+            std::unique_ptr<unsigned char[]> m_Storage;
+            T* m_Data;
+            std::size_t m_Size;
+            std::size_t m_Capacity;
+        };
+
+        // Reduction kernels used by the reduction combiners.
+        // The pointer must be aligned to 32 bytes and count must not be 0.
+        // The portable kernels are used for any arithmetic type. The float
+        // and double overloads use SSE2 or AVX when available. The SIMD
+        // kernels add the values in a different order than the portable
+        // kernels so floating-point sums may differ in the last bits. The
+        // result of minimum and maximum is unspecified if the values contain NaN.
+        namespace simd
+        {
+            template<typename T>
+            T sum(const T* p, std::size_t count)
             {
-                return m_Ptr == rhs.m_Ptr;
+                T result = T();
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    result += p[i];
+                }
+                return result;
             }
 
-            template<typename U>
-            bool operator!=(const cow_ptr<U>& rhs) const noexcept
+            template<typename T>
+            T minimum(const T* p, std::size_t count)
             {
-                return m_Ptr != rhs.m_Ptr;
+                T result = p[0];
+                for (std::size_t i = 1; i < count; ++i)
+                {
+                    if (p[i] < result) result = p[i];
+                }
+                return result;
             }
 
-            // Explicit bool conversion to check for a valid
-            // internal value.
-            explicit operator bool() const noexcept
+            template<typename T>
+            T maximum(const T* p, std::size_t count)
             {
-                return bool(m_Ptr);
+                T result = p[0];
+                for (std::size_t i = 1; i < count; ++i)
+                {
+                    if (result < p[i]) result = p[i];
+                }
+                return result;
             }
 
-        private:
-            void detach()
+#if defined(SIG_SSE2) || defined(SIG_AVX)
+            // Combine the lanes of a register with the scalar operation and
+            // reduce the remaining values that did not fill a register.
+            template<typename T, std::size_t Lanes, typename Op>
+            T reduce_lanes(const T (&lanes)[Lanes], const T* p, std::size_t first, std::size_t count, Op op)
             {
-                if (m_Ptr && m_Ptr.use_count() > 1)
+                T result = lanes[0];
+                for (std::size_t i = 1; i < Lanes; ++i)
                 {
-                    // Detach from the shared pointer
-                    // creating a new instance of the stored object.
-                    *this = cow_ptr(new T(*m_Ptr));
+                    result = op(result, lanes[i]);
+                }
+                for (std::size_t i = first; i < count; ++i)
+                {
+                    result = op(result, p[i]);
                 }
+                return result;
             }
 
-            pointer_type m_Ptr;
-        };
+            struct add_op
+            {
+                template<typename T>
+                T operator()(T a, T b) const { return a + b; }
+            };
 
-        // Utility function to create a cow_ptr.
-        template<typename T, typename... Args>
-        cow_ptr<T> make_cow(Args&&... args)
-        {
-            return cow_ptr<T>(new T(std::forward<Args>(args)...));
-        }
+            struct min_op
+            {
+                template<typename T>
+                T operator()(T a, T b) const { return b < a ? b : a; }
+            };
 
-        template<typename T, typename U, typename... Args>
-        cow_ptr<T> make_cow(std::initializer_list<U> il, Args&&... args)
-        {
-            return cow_ptr<T>(new T(il, std::forward<Args>(args)...));
-        }
+            struct max_op
+            {
+                template<typename T>
+                T operator()(T a, T b) const { return a < b ? b : a; }
+            };
+#endif
+
+#if defined(SIG_AVX)
+            // Defines a float and a double kernel using 256-bit AVX registers.
+#define SIG_SIMD_KERNEL(name, op, ps_op, pd_op, ps_init, pd_init)       \
+            inline float name(const float* p, std::size_t count)        \
+            {                                                           \
+                std::size_t i = 0;                                      \
+                __m256 acc = ps_init;                                   \
+                for (; i + 8 <= count; i += 8)                          \
+                {                                                       \
+                    acc = ps_op(acc, _mm256_load_ps(p + i));            \
+                }                                                       \
+                alignas(32) float lanes[8];                             \
+                _mm256_store_ps(lanes, acc);                            \
+                return reduce_lanes(lanes, p, i, count, op());          \
+            }                                                           \
+            inline double name(const double* p, std::size_t count)      \
+            {                                                           \
+                std::size_t i = 0;                                      \
+                __m256d acc = pd_init;                                  \
+                for (; i + 4 <= count; i += 4)                          \
+                {                                                       \
+                    acc = pd_op(acc, _mm256_load_pd(p + i));            \
+                }                                                       \
+                alignas(32) double lanes[4];                            \
+                _mm256_store_pd(lanes, acc);                            \
+                return reduce_lanes(lanes, p, i, count, op());          \
+            }
 
-        /**
-         * Slot state is used as both a non-template base class for slot_impl
-         * as well as storing connection information about the slot.
-         */
-        class slot_state
+            SIG_SIMD_KERNEL(sum, add_op, _mm256_add_ps, _mm256_add_pd, _mm256_setzero_ps(), _mm256_setzero_pd())
+            SIG_SIMD_KERNEL(minimum, min_op, _mm256_min_ps, _mm256_min_pd, _mm256_set1_ps(p[0]), _mm256_set1_pd(p[0]))
+            SIG_SIMD_KERNEL(maximum, max_op, _mm256_max_ps, _mm256_max_pd, _mm256_set1_ps(p[0]), _mm256_set1_pd(p[0]))
+#undef SIG_SIMD_KERNEL
+#elif defined(SIG_SSE2)
+            // Defines a float and a double kernel using 128-bit SSE2 registers.
+#define SIG_SIMD_KERNEL(name, op, ps_op, pd_op, ps_init, pd_init)       \
+            inline float name(const float* p, std::size_t count)        \
+            {                                                           \
+                std::size_t i = 0;                                      \
+                __m128 acc = ps_init;                                   \
+                for (; i + 4 <= count; i += 4)                          \
+                {                                                       \
+                    acc = ps_op(acc, _mm_load_ps(p + i));               \
+                }                                                       \
+                alignas(16) float lanes[4];                             \
+                _mm_store_ps(lanes, acc);                               \
+                return reduce_lanes(lanes, p, i, count, op());          \
+            }                                                           \
+            inline double name(const double* p, std::size_t count)      \
+            {                                                           \
+                std::size_t i = 0;                                      \
+                __m128d acc = pd_init;                                  \
+                for (; i + 2 <= count; i += 2)                          \
+                {                                                       \
+                    acc = pd_op(acc, _mm_load_pd(p + i));               \
+                }                                                       \
+                alignas(16) double lanes[2];                            \
+                _mm_store_pd(lanes, acc);                               \
+                return reduce_lanes(lanes, p, i, count, op());          \
+            }
+
+            SIG_SIMD_KERNEL(sum, add_op, _mm_add_ps, _mm_add_pd, _mm_setzero_ps(), _mm_setzero_pd())
+            SIG_SIMD_KERNEL(minimum, min_op, _mm_min_ps, _mm_min_pd, _mm_set1_ps(p[0]), _mm_set1_pd(p[0]))
+            SIG_SIMD_KERNEL(maximum, max_op, _mm_max_ps, _mm_max_pd, _mm_set1_ps(p[0]), _mm_set1_pd(p[0]))
+#undef SIG_SIMD_KERNEL
+#endif
+        } // namespace simd
+
+        // Base class for the reduction combiners.
+        // Collects the engaged results of the slots into blocks on the stack
+        // that are aligned for SIMD loads, and reduces the results one block
+        // at a time. The combiners don't have any state, so the same combiner
+        // can be used by invocations of the signal from multiple threads at
+        // the same time, and invoking it never allocates memory.
+        template<typename T>
+        class reduce_combiner
         {
         public:
-            constexpr slot_state() noexcept
-                : m_Index(0)
-                , m_Connected(true)
-                , m_Blocked(false)
-            {}
-
-            // Atomic variables are not CopyConstructible.
-            // @see https://en.cppreference.com/w/cpp/atomic/atomic/atomic
-            slot_state(const slot_state& s) noexcept
-                : m_Index(s.m_Index)
-                , m_Connected(s.m_Connected.load())
-                , m_Blocked(s.m_Blocked.load())
-            {}
-
-            slot_state(slot_state&& s) noexcept
-                : m_Index(s.m_Index)
-                , m_Connected(s.m_Connected.load())
-                , m_Blocked(s.m_Blocked.load())
-            {}
+            static_assert(std::is_arithmetic<T>::value, "Reduction combiners require an arithmetic type.");
 
-            virtual ~slot_state() = default;
+            // The number of results that are reduced at a time.
+            static constexpr std::size_t block_size = 64;
 
-            slot_state& operator=(const slot_state& s) noexcept
+        protected:
+            // Call reduce(values, count) for every block of engaged results.
+            // @returns The number of engaged results.
+            template<typename InputIterator, typename Reduce>
+            static std::size_t reduce_blocks(InputIterator first, InputIterator last, Reduce reduce)
             {
-                m_Index = s.m_Index;
-                m_Connected = s.m_Connected.load();
-                m_Blocked = s.m_Blocked.load();
+                alignas(32) T values[block_size];
+                std::size_t count = 0;
+                std::size_t total = 0;
+                for (; first != last; ++first)
+                {
+                    auto value = *first;
+                    if (value)
+                    {
+                        values[count++] = *value;
+                        if (count == block_size)
+                        {
+                            reduce(static_cast<const T*>(values), count);
+                            total += count;
+                            count = 0;
+                        }
+                    }
+                }
 
-                return *this;
+                if (count > 0)
+                {
+                    reduce(static_cast<const T*>(values), count);
+                    total += count;
+                }
+                return total;
             }
+        };
+    } // namespace detail
 
-            slot_state& operator=(slot_state&& s) noexcept
+    // Combiner that returns the sum of the engaged results of all slots.
+    // If no slot returns an engaged value, a disengaged optional is returned.
+    template<typename T>
+    class sum_value : public detail::reduce_combiner<T>
+    {
+    public:
+        using result_type = opt::optional<T>;
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            T result = T();
+            const auto count = this->reduce_blocks(first, last, [&result](const T* p, std::size_t n)
             {
-                m_Index = s.m_Index;
-                m_Connected.store(s.m_Connected.load());
-                m_Blocked.store(s.m_Blocked.load());
+                result += detail::simd::sum(p, n);
+            });
+            if (count == 0) return {};
+            return result;
+        }
+    };
 
-                return *this;
-            }
+    // Combiner that returns the smallest engaged result of all slots.
+    // If no slot returns an engaged value, a disengaged optional is returned.
+    template<typename T>
+    class min_value : public detail::reduce_combiner<T>
+    {
+    public:
+        using result_type = opt::optional<T>;
 
-            virtual bool connected() const noexcept
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            result_type result;
+            this->reduce_blocks(first, last, [&result](const T* p, std::size_t n)
             {
-                return m_Connected;
-            }
+                const auto value = detail::simd::minimum(p, n);
+                if (!result || value < *result) result = value;
+            });
+            return result;
+        }
+    };
 
-            bool disconnect() noexcept
+    // Combiner that returns the largest engaged result of all slots.
+    // If no slot returns an engaged value, a disengaged optional is returned.
+    template<typename T>
+    class max_value : public detail::reduce_combiner<T>
+    {
+    public:
+        using result_type = opt::optional<T>;
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            result_type result;
+            this->reduce_blocks(first, last, [&result](const T* p, std::size_t n)
             {
-                return m_Connected.exchange(false);
-            }
+                const auto value = detail::simd::maximum(p, n);
+                if (!result || *result < value) result = value;
+            });
+            return result;
+        }
+    };
 
-            bool blocked() const noexcept
+    // Combiner that returns the mean of the engaged results of all slots.
+    // For integral types, the result is rounded towards zero.
+    // If no slot returns an engaged value, a disengaged optional is returned.
+    template<typename T>
+    class mean_value : public detail::reduce_combiner<T>
+    {
+    public:
+        using result_type = opt::optional<T>;
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last) const
+        {
+            T sum = T();
+            const auto count = this->reduce_blocks(first, last, [&sum](const T* p, std::size_t n)
             {
-                return m_Blocked;
-            }
+                sum += detail::simd::sum(p, n);
+            });
+            if (count == 0) return {};
+            return static_cast<T>(sum / static_cast<T>(count));
+        }
+    };
 
-            void block() noexcept
+    // Combiner adapter that gives each emitting thread its own copy of the
+    // combiner. Use this for stateful combiners on signals that are invoked
+    // from multiple threads concurrently. Each thread's copy is created from
+    // the prototype the first time the thread invokes the signal and is kept
+    // until the thread exits or the per_thread combiner is destroyed.
+    // The mutex is only locked when a thread uses the combiner for the first
+    // time, when a thread exits, and when the per_thread combiner is destroyed.
+    template<typename Combiner>
+    class per_thread
+    {
+    public:
+        using result_type = typename Combiner::result_type;
+        using combiner_type = Combiner;
+
+        explicit per_thread(Combiner prototype = Combiner())
+            : m_Prototype(std::move(prototype))
+            , m_State(std::make_shared<state_type>())
+        {}
+
+        // Copies only the prototype, not the per-thread instances.
+        per_thread(const per_thread& other)
+            : m_Prototype(other.m_Prototype)
+            , m_State(std::make_shared<state_type>())
+        {}
+
+        // Replaces the prototype and releases the per-thread instances.
+        per_thread& operator=(const per_thread& other)
+        {
+            if (this != &other)
             {
-                m_Blocked = true;
+                release();
+                m_Prototype = other.m_Prototype;
+                m_State = std::make_shared<state_type>();
             }
+            return *this;
+        }
 
-            void unblock() noexcept
+        ~per_thread()
+        {
+            release();
+        }
+
+        // Get the combiner for the calling thread.
+        Combiner& local()
+        {
+            auto& entries = thread_entries().entries;
+            for (auto& entry : entries)
             {
-                m_Blocked = false;
+                if (entry.state.get() == m_State.get())
+                {
+                    return *entry.combiner;
+                }
             }
 
-            std::size_t& index()
+            return create(entries);
+        }
+
+        template<typename InputIterator>
+        result_type operator()(InputIterator first, InputIterator last)
+        {
+            return local()(first, last);
+        }
+
+    private:
+        // The per-thread instances of a per_thread combiner.
+        // Shared with the threads that use it, so a thread that exits after
+        // the per_thread combiner was destroyed can still lock the mutex.
+        struct state_type
+        {
+            state_type()
+                : alive(true)
+            {}
+
+            std::mutex mutex;
+            std::list<Combiner> combiners;  // Stable addresses.
+            std::atomic_bool alive;
+        };
+
+        // The instance of the calling thread in one per_thread combiner.
+        struct entry_type
+        {
+            std::shared_ptr<state_type> state;
+            typename std::list<Combiner>::iterator combiner;
+        };
+
+        // The instances of the calling thread in all per_thread combiners
+        // of this type. They are released when the thread exits.
+        struct thread_entries_type
+        {
+            ~thread_entries_type()
             {
-                return m_Index;
+                for (auto& entry : entries)
+                {
+                    std::lock_guard<std::mutex> lock(entry.state->mutex);
+                    if (entry.state->alive)
+                    {
+                        entry.state->combiners.erase(entry.combiner);
+                    }
+                }
             }
 
-        private:
-            std::size_t m_Index;
-            std::atomic_bool m_Connected;
-            std::atomic_bool m_Blocked;
+            std::vector<entry_type> entries;
         };
 
-        // Base class for slot implementations.
-        template<typename R, typename... Args>
-        class slot_impl : public slot_state
+        static thread_entries_type& thread_entries()
         {
-        public:
-            virtual ~slot_impl() = default;
-            virtual slot_impl* clone() const = 0;
-            virtual bool equals(const slot_impl* s) const = 0;
-            virtual opt::optional<R> operator()(Args&&... args) = 0;
-        };
+            static thread_local thread_entries_type entries;
+            return entries;
+        }
 
-        // Slot implementation for callable function objects (Functors)
-        template<typename R, typename Func, typename... Args>
-        class slot_func : public slot_impl<R, Args...>
+        // Create the instance of the calling thread from the prototype.
+        Combiner& create(std::vector<entry_type>& entries)
         {
-        public:
-            using fuction_type = traits::decay_t<Func>;
+            // Forget the instances of per_thread combiners that were destroyed.
+            entries.erase(std::remove_if(entries.begin(), entries.end(), [](const entry_type& entry)
+            {
+                return !entry.state->alive;
+            }), entries.end());
+            entries.reserve(entries.size() + 1);
+
+            std::lock_guard<std::mutex> lock(m_State->mutex);
+            auto combiner = m_State->combiners.insert(m_State->combiners.end(), m_Prototype);
+            entries.push_back(entry_type{ m_State, combiner });
+            return *combiner;
+        }
+
+        // Release the instances of all threads.
+        void release()
+        {
+            std::lock_guard<std::mutex> lock(m_State->mutex);
+            m_State->alive = false;
+            m_State->combiners.clear();
+        }
+
+        Combiner m_Prototype;
+        std::shared_ptr<state_type> m_State;
+    };
+
+    // Slot storage policy for signals.
+    // Up to N slots are stored inside the signal object. Larger slot lists
+    // are stored in a copy-on-write vector on the heap.
+    template<std::size_t N>
+    struct inline_slots
+    {
+        template<typename T>
+        using list_type = detail::slot_list<T, N>;
+    };
+
+    // Slot storage policy for signals with many slots that are connected or
+    // disconnected while the signal is invoked.
+    // The slots are stored in chunks of ChunkSize slots. Connecting or
+    // disconnecting a slot while the slot list is shared with an invocation
+    // only copies the chunk of the slot and one pointer per chunk, instead of
+    // the whole slot list.
+    template<std::size_t ChunkSize = 64>
+    struct chunked_slots
+    {
+        template<typename T>
+        using list_type = detail::chunked_slot_list<T, ChunkSize>;
+    };
+
+    // Slot policy for signals whose slots may be invoked in any order.
+    // A connected slot is stored after the slots of the same type (for example,
+    // the same lambda or the same pointer to member function type) in its
+    // group, instead of at the position it was connected to. Slots of the same
+    // type are invoked back-to-back, which is friendlier to the branch
+    // predictor and the instruction cache when many slot types are connected.
+    // Groups are still invoked in order. The slots are stored like the slots
+    // of SlotStorage.
+    template<typename SlotStorage = inline_slots<SIG_INLINE_SLOTS>>
+    struct type_grouped_slots : SlotStorage
+    {
+        static constexpr bool group_by_type = true;
+    };
+
+    // Slot policy for signals whose slots must not throw (see nothrow_signal).
+    // The slots are stored like the slots of SlotStorage.
+    template<typename SlotStorage = inline_slots<SIG_INLINE_SLOTS>>
+    struct nothrow_slots : SlotStorage
+    {
+        static constexpr bool nothrow = true;
+    };
+
+    namespace detail
+    {
+        // Detect a slot policy that requires nothrow slots.
+        template<typename SlotStorage, typename = void>
+        struct is_nothrow_storage : std::false_type
+        {};
+
+        template<typename SlotStorage>
+        struct is_nothrow_storage<SlotStorage, traits::void_t<decltype(SlotStorage::nothrow)>>
+            : std::integral_constant<bool, SlotStorage::nothrow>
+        {};
 
-            slot_func(const slot_func&) = default;  // Copy constructor.
+        // Detect a slot policy that groups the slots by their type.
+        template<typename SlotStorage, typename = void>
+        struct is_type_grouped_storage : std::false_type
+        {};
 
-            slot_func(Func&& func)
-                : m_Func{ std::forward<Func>(func) }
-            {}
+        template<typename SlotStorage>
+        struct is_type_grouped_storage<SlotStorage, traits::void_t<decltype(SlotStorage::group_by_type)>>
+            : std::integral_constant<bool, SlotStorage::group_by_type>
+        {};
+    } // namespace detail
 
-            virtual slot_impl<R, Args...>* clone() const override
-            {
-                return new slot_func(*this);
-            }
+    // Specifies where a slot is connected relative to the other slots
+    // in the same group (or the other ungrouped slots).
+    enum connect_position
+    {
+        at_back,
+        at_front
+    };
 
-            virtual bool equals(const slot_impl<R, Args...>* s) const override
-            {
-                if (auto sfunc = dynamic_cast<const slot_func*>(s))
-                {
-                    return try_equals<fuction_type>::equals(m_Func, sfunc->m_Func);
-                }
+    // Primary template for the signal.
+    template<typename Func, typename Combiner = optional_last_value<typename detail::traits::function_traits<Func>::result_type>,
+        typename SlotStorage = inline_slots<SIG_INLINE_SLOTS>>
+    class signal;
 
-                return false;
-            }
+    // A signal whose slots must not throw.
+    // Connecting a function object that is not noexcept (or a sig::slot, whose
+    // function object is not known) is a compile error, and invoking the
+    // signal is noexcept. If the combiner or a copy of the arguments throws
+    // while the signal is invoked, std::terminate is called.
+    template<typename Func, typename Combiner = optional_last_value<typename detail::traits::function_traits<Func>::result_type>,
+        typename SlotStorage = inline_slots<SIG_INLINE_SLOTS>>
+    using nothrow_signal = signal<Func, Combiner, nothrow_slots<SlotStorage>>;
 
-            virtual opt::optional<R> operator()(Args&&... args) override
-            {
-                return invoke_helper<fuction_type>::call(m_Func, std::forward<Args>(args)...);
-            }
+    // Partial specialization taking a callable.
+    //
+    // Slots are invoked in the following order:
+    //   1. Ungrouped slots connected at_front.
+    //   2. Grouped slots, in ascending group order.
+    //   3. Ungrouped slots connected at_back.
+    // All slots are stored in a single contiguous list. The group boundaries
+    // are stored in a sorted (flat) array of group buckets so that emission is
+    // a linear scan over the slot list and finding a group is a binary search.
+    // A connection finds its slot with a binary search over the slot keys,
+    // so connecting or disconnecting a slot doesn't update the other slots.
+    template<typename R, typename... Args, typename Combiner, typename SlotStorage>
+    class signal<R(Args...), Combiner, SlotStorage> : detail::signal_base
+    {
+    public:
+        using slot_type = slot<R(Args...)>;
+        using slot_ptr_type = std::shared_ptr<slot_type>;
+        using list_type = typename SlotStorage::template list_type<slot_ptr_type>;
+        using list_iterator = typename list_type::const_iterator;
+        // The slot lists of a signal and the signals that it forwards to.
+        using snapshot_list = detail::slot_list<list_type, SIG_INLINE_FORWARDS + 1>;
+#if SIG_SIGNAL_STATS
+        using mutex_type = detail::counted_mutex;
+#else
+        using mutex_type = std::mutex;
+#endif
+        using lock_type = std::unique_lock<mutex_type>;
+        using result_type = typename Combiner::result_type;
+        using group_type = int;
+        using args_type = std::tuple<Args...>;
 
-        private:
-            fuction_type m_Func;
-        };
+        // True if the slots must not throw (see nothrow_signal).
+        static constexpr bool is_nothrow = detail::is_nothrow_storage<SlotStorage>::value;
 
-        // Specialization for void return types.
-        template<typename Func, typename... Args>
-        class slot_func<void, Func, Args...> : public slot_impl<void, Args...>
-        {
-        public:
-            using fuction_type = traits::decay_t<Func>;
+        // True if the slots are grouped by their type (see type_grouped_slots).
+        static constexpr bool is_type_grouped = detail::is_type_grouped_storage<SlotStorage>::value;
 
-            slot_func(const slot_func&) = default;  // Copy constructor.
+        signal()
+            : m_FrontSlots(0)
+            , m_ThrowingSlots(0)
+            , m_Name(nullptr)
+            , m_Blocked(false)
+            , m_ExpiredSlots(false)
+        {}
 
-            slot_func(Func&& func)
-                : m_Func{ std::forward<Func>(func) }
-            {}
+        // Construct a signal that uses the given combiner instance.
+        // The combiner is kept by the signal and passed by reference
+        // on every invocation so it may keep state between invocations.
+        explicit signal(Combiner combiner)
+            : m_Combiner(std::move(combiner))
+            , m_FrontSlots(0)
+            , m_ThrowingSlots(0)
+            , m_Name(nullptr)
+            , m_Blocked(false)
+            , m_ExpiredSlots(false)
+        {}
 
-            virtual slot_impl<void, Args...>* clone() const override
+        // Stop forwarding to and from this signal.
+        ~signal()
+        {
+            std::lock_guard<std::mutex> graph(detail::forwarding_mutex());
+            for (auto target : m_Forwards)
             {
-                return new slot_func(*this);
+                remove_forward(target->m_Sources, this);
+            }
+            for (auto source : m_Sources)
+            {
+                lock_type lock(source->m_SlotMutex);
+                remove_forward(source->m_Forwards, this);
             }
 
-            virtual bool equals(const slot_impl<void, Args...>* s) const override
+            // An invocation of a source that copied the slots of this signal
+            // before it was removed may still be running. Disconnect the
+            // slots so that they are skipped and don't refer to this signal.
+            if (!m_Sources.empty())
             {
-                if (auto sfunc = dynamic_cast<const slot_func*>(s))
+                lock_type lock(m_SlotMutex);
+                const auto& slots = m_Slots;
+                for (auto iter = slots.begin(); iter != slots.end(); ++iter)
                 {
-                    return try_equals<fuction_type>::equals(m_Func, sfunc->m_Func);
+                    (*iter)->state().disconnect();
                 }
-
-                return false;
             }
+        }
 
-            virtual opt::optional<void> operator()(Args&&... args) override
-            {
-                return (invoke_helper<fuction_type>::call(m_Func, std::forward<Args>(args)...), opt::nullopt);
-            }
+        // Not copyable.
+        signal(const signal&) = delete;
+        // Not copy assignable.
+        signal& operator=(const signal&) = delete;
 
-        private:
-            fuction_type m_Func;
-        };
+        // Moveable.
+        // Forwarding relationships are not moved.
+        signal(signal&& other) noexcept
+            : m_Combiner(std::move(other.m_Combiner))
+            , m_Name(other.m_Name)
+            , m_Blocked(other.m_Blocked.load())
+            , m_ExpiredSlots(other.m_ExpiredSlots.exchange(false))
+        {
+            lock_type lock(other.m_SlotMutex);
+            m_Slots = std::move(other.m_Slots);
+            m_Groups = std::move(other.m_Groups);
+            m_FrontSlots = other.m_FrontSlots;
+            other.m_FrontSlots = 0;
+            m_ThrowingSlots = other.m_ThrowingSlots;
+            other.m_ThrowingSlots = 0;
+#if SIG_SIGNAL_STATS
+            m_SlotMutex.counters().set_name(m_Name);
+            m_SlotMutex.counters().update_peak(m_Slots.size());
+#endif
+        }
 
-        // Slot implementation for pointer to member function and
-        // pointer to member data.
-        template<typename R, typename Func, typename Ptr, typename... Args>
-        class slot_pmf : public slot_impl<R, Args...>
+        // Move assignable.
+        signal& operator=(signal&& other) noexcept
         {
-        public:
-            using function_type = traits::decay_t<Func>;
-            using pointer_type = traits::decay_t<Ptr>;
+            lock_type lock1(m_SlotMutex, std::defer_lock);
+            lock_type lock2(other.m_SlotMutex, std::defer_lock);
+            std::lock(lock1, lock2);
 
-            slot_pmf(const slot_pmf&) = default;
+            m_Slots = std::move(other.m_Slots);
+            m_Groups = std::move(other.m_Groups);
+            m_FrontSlots = other.m_FrontSlots;
+            other.m_FrontSlots = 0;
+            m_ThrowingSlots = other.m_ThrowingSlots;
+            other.m_ThrowingSlots = 0;
+            m_Blocked = other.m_Blocked.load();
+            m_ExpiredSlots = other.m_ExpiredSlots.exchange(false);
+            m_Combiner = std::move(other.m_Combiner);
+            m_Name = other.m_Name;
+#if SIG_SIGNAL_STATS
+            m_SlotMutex.counters().set_name(m_Name);
+            m_SlotMutex.counters().update_peak(m_Slots.size());
+#endif
 
-            slot_pmf(Func&& func, Ptr&& ptr)
-                : m_Ptr{ std::forward<Ptr>(ptr) }
-                , m_Func{ std::forward<Func>(func) }
-            {}
+            return *this;
+        }
 
-            virtual slot_impl<R, Args...>* clone() const override
-            {
-                return new slot_pmf(*this);
-            }
+        // Connect a previously created slot
+        connection connect(const slot_type& slot, connect_position position = at_back)
+        {
+            static_assert(!is_nothrow, "Connect a noexcept function object to a nothrow_signal");
 
-            virtual bool equals(const slot_impl<R, Args...>* s) const override
-            {
-                if (auto spmf = dynamic_cast<const slot_pmf*>(s))
-                {
-                    return try_equals<pointer_type>::equals(m_Ptr, spmf->m_Ptr) &&
-                        try_equals<function_type>::equals(m_Func, spmf->m_Func);
-                }
+            auto s = std::make_shared<slot_type>(slot, static_cast<detail::signal_base*>(this));
+            connection c(s);
+            add_slot(std::move(s), position);
+            return c;
+        }
 
-                return false;
-            }
+        // Connect a previously created slot to a group.
+        connection connect(group_type group, const slot_type& slot, connect_position position = at_back)
+        {
+            static_assert(!is_nothrow, "Connect a noexcept function object to a nothrow_signal");
 
-            virtual opt::optional<R> operator()(Args&&... args) override
-            {
-                return invoke_helper<function_type>::call(m_Func, m_Ptr, std::forward<Args>(args)...);
-            }
+            auto s = std::make_shared<slot_type>(slot, static_cast<detail::signal_base*>(this));
+            connection c(s);
+            add_slot(std::move(s), group, position);
+            return c;
+        }
 
-        private:
-            pointer_type m_Ptr;
-            function_type m_Func;
-        };
+        // Connect a slot with a callable function object.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Args...>::value>,
+            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
+        connection connect(Func&& f, connect_position position = at_back)
+        {
+            auto s = slot_type::template make_func<is_nothrow>(static_cast<detail::signal_base*>(this), std::forward<Func>(f));
+            connection c(s);
+            add_slot(std::move(s), position);
+            return c;
+        }
 
-        // Slot implementation for pointer to member function and
-        // pointer to member data.
-        // Specialized on void return value.
-        template<typename Func, typename Ptr, typename... Args>
-        class slot_pmf<void, Func, Ptr, Args...> : public slot_impl<void, Args...>
+        // Connect a slot with a callable function object to a group.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Args...>::value>,
+            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
+        connection connect(group_type group, Func&& f, connect_position position = at_back)
         {
-        public:
-            using function_type = traits::decay_t<Func>;
-            using pointer_type = traits::decay_t<Ptr>;
+            auto s = slot_type::template make_func<is_nothrow>(static_cast<detail::signal_base*>(this), std::forward<Func>(f));
+            connection c(s);
+            add_slot(std::move(s), group, position);
+            return c;
+        }
 
-            slot_pmf(const slot_pmf&) = default;
+        // Connect a slot with a pointer to member function.
+        // or pointer to member data.
+        template<typename Func, typename Ptr, 
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Ptr, Args...>::value>,
+            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
+        connection connect(Func&& f, Ptr&& p, connect_position position = at_back)
+        {
+            auto s = slot_type::template make_func<is_nothrow>(static_cast<detail::signal_base*>(this), std::forward<Func>(f), std::forward<Ptr>(p));
+            connection c(s);
+            add_slot(std::move(s), position);
+            return c;
+        }
 
-            slot_pmf(Func&& func, Ptr&& ptr)
-                : m_Ptr{ std::forward<Ptr>(ptr) }
-                , m_Func{ std::forward<Func>(func) }
-            {}
+        // Connect a slot with a pointer to member function
+        // or pointer to member data to a group.
+        template<typename Func, typename Ptr,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Ptr, Args...>::value>,
+            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
+        connection connect(group_type group, Func&& f, Ptr&& p, connect_position position = at_back)
+        {
+            auto s = slot_type::template make_func<is_nothrow>(static_cast<detail::signal_base*>(this), std::forward<Func>(f), std::forward<Ptr>(p));
+            connection c(s);
+            add_slot(std::move(s), group, position);
+            return c;
+        }
 
-            virtual slot_impl<void, Args...>* clone() const override
-            {
-                return new slot_pmf(*this);
-            }
+        // Connect a function that is bound at compile time.
+        // The slot does not store a function pointer, so invoking the slot
+        // calls the function directly.
+        //   s.connect<decltype(&func), &func>();
+        //   s.connect<&func>();  // C++17
+        template<typename FuncT, FuncT Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, FuncT, Args...>::value>>
+        connection connect(connect_position position = at_back)
+        {
+            auto s = slot_type::template make<detail::slot_bound<R, FuncT, Func, Args...>, is_nothrow>(static_cast<detail::signal_base*>(this));
+            connection c(s);
+            add_slot(std::move(s), position);
+            return c;
+        }
 
-            virtual bool equals(const slot_impl<void, Args...>* s) const override
-            {
-                if (auto spmf = dynamic_cast<const slot_pmf*>(s))
-                {
-                    return try_equals<pointer_type>::equals(m_Ptr, spmf->m_Ptr) &&
-                        try_equals<function_type>::equals(m_Func, spmf->m_Func);
-                }
+        // Connect a pointer to member function that is bound at compile time.
+        // The slot only stores the object pointer. The lifetime of the object
+        // is tracked if the pointer is convertible to a std::weak_ptr.
+        //   s.connect<decltype(&T::method), &T::method>(obj);
+        //   s.connect<&T::method>(obj);  // C++17
+        template<typename FuncT, FuncT Func, typename Ptr,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, FuncT, Ptr, Args...>::value>>
+        connection connect(Ptr&& p, connect_position position = at_back)
+        {
+            using bound = bound_pmf<FuncT, Func, Ptr>;
+            auto s = slot_type::template make<typename bound::type, is_nothrow>(static_cast<detail::signal_base*>(this), bound::pointer(std::forward<Ptr>(p)));
+            connection c(s);
+            add_slot(std::move(s), position);
+            return c;
+        }
 
-                return false;
-            }
+#if SIG_CPP17
+        // Connect a function that is bound at compile time.
+        template<auto Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, decltype(Func), Args...>::value>>
+        connection connect(connect_position position = at_back)
+        {
+            return connect<decltype(Func), Func>(position);
+        }
 
-            virtual opt::optional<void> operator()(Args&&... args) override
-            {
-                invoke_helper<function_type>::call(m_Func, m_Ptr, std::forward<Args>(args)...);
-                return {};
-            }
+        // Connect a pointer to member function that is bound at compile time.
+        template<auto Func, typename Ptr,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, decltype(Func), Ptr, Args...>::value>>
+        connection connect(Ptr&& p, connect_position position = at_back)
+        {
+            return connect<decltype(Func), Func>(std::forward<Ptr>(p), position);
+        }
+#endif
 
-        private:
-            pointer_type m_Ptr;
-            function_type m_Func;
-        };
+        // Connect a slot with a reference to a callable object.
+        // The callable object is not copied and must outlive the connection.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<!std::is_reference<Func>::value>,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, Func&, Args...>::value>>
+        connection connect(slot_ref<Func> f, connect_position position = at_back)
+        {
+            using ref_type = detail::slot_func<R, slot_ref<Func>, Args...>;
 
-        // Slot implementation for pointer to member function that automatically 
-        // tracks the lifetime of a supplied object through a weak pointer in 
-        // order to disconnect the slot on object destruction.
-        template<typename R, typename Func, typename WeakPtr, typename... Args>
-        class slot_pmf_tracked : public slot_impl<R, Args...>
+            auto s = slot_type::template make<ref_type, is_nothrow>(static_cast<detail::signal_base*>(this), std::move(f));
+            connection c(s);
+            add_slot(std::move(s), position);
+            return c;
+        }
+
+        // Connect a slot with a callable function object that is only invoked
+        // if the predicate of the filter returns true for the arguments.
+        // The predicate is evaluated before the slot is invoked.
+        template<typename Pred, typename Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Args...>::value>,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<bool, const Pred&, Args&...>::value>>
+        connection connect(slot_filter<Pred> filter, Func&& f, connect_position position = at_back)
         {
-        public:
-            using function_type = traits::decay_t<Func>;
-            using pointer_type = traits::decay_t<WeakPtr>;
+            using filtered_type = detail::slot_filtered<R, Pred, Func, Args...>;
 
-            slot_pmf_tracked(const slot_pmf_tracked&) = default;
+            auto s = slot_type::template make<filtered_type, is_nothrow>(static_cast<detail::signal_base*>(this), std::move(filter.pred), std::forward<Func>(f));
+            connection c(s);
+            add_slot(std::move(s), position);
+            return c;
+        }
 
-            slot_pmf_tracked(Func&& func, WeakPtr&& ptr)
-                : m_Ptr{ std::forward<WeakPtr>(ptr) }
-                , m_Func{ std::forward<Func>(func) }
-            {}
+        // Connect an extended slot.
+        // The function object is invoked with a connection_handle to its own
+        // connection as the first argument followed by the signal arguments.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, connection_handle&, Args...>::value>>
+        connection connect_extended(Func&& f, connect_position position = at_back)
+        {
+            auto s = make_extended_slot(std::forward<Func>(f));
+            connection c(s);
+            add_slot(std::move(s), position);
+            return c;
+        }
 
-            virtual bool connected() const noexcept override
-            {
-                return !m_Ptr.expired() && slot_state::connected();
-            }
+        // Connect an extended slot to a group.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, connection_handle&, Args...>::value>>
+        connection connect_extended(group_type group, Func&& f, connect_position position = at_back)
+        {
+            auto s = make_extended_slot(std::forward<Func>(f));
+            connection c(s);
+            add_slot(std::move(s), group, position);
+            return c;
+        }
+
+        // Connect a previously created slot.
+        // Returns a scoped_connection.
+        scoped_connection connect_scoped(const slot_type& slot)
+        {
+            return scoped_connection(connect(slot));
+        }
+
+        // Connect a slot with a callable function object.
+        // Returns a scoped connection.
+        template<typename Func, 
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Args...>::value>,
+            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
+        scoped_connection connect_scoped(Func&& f)
+        {
+            return scoped_connection(connect<Func>(std::forward<Func>(f)));
+        }
+
+        // Connect a slot with a pointer to member function
+        // or pointer to member data.
+        // Returns a scoped connection.
+        template<typename Func, typename Ptr, 
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, Func, Ptr, Args...>::value>,
+            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
+        scoped_connection connect_scoped(Func&& f, Ptr&& p)
+        {
+            return scoped_connection(connect<Func>(std::forward<Func>(f), std::forward<Ptr>(p)));
+        }
+
+        // Disconnect a slot.
+        std::size_t disconnect(const slot_type& slot)
+        {
+            return erase(slot);
+        }
 
-            virtual slot_impl<R, Args...>* clone() const override
-            {
-                return new slot_pmf_tracked(*this);
-            }
+        // Disconnect all slots in a group.
+        // Returns the number of slots that were disconnected.
+        std::size_t disconnect(group_type group)
+        {
+            lock_type lock(m_SlotMutex);
+            purge_expired();
 
-            virtual bool equals(const slot_impl<R, Args...>* s) const override
+            auto iter = find_group(group);
+            if (iter == m_Groups.end() || iter->group != group)
             {
-                if (auto spmft = dynamic_cast<const slot_pmf_tracked*>(s))
-                {
-                    return try_equals<pointer_type>::equals(m_Ptr, spmft->m_Ptr) &&
-                        try_equals<function_type>::equals(m_Func, spmft->m_Func);
-                }
-
-                return false;
+                return 0;
             }
 
-            virtual opt::optional<R> operator()(Args&&... args) override
+            const auto first = group_begin(iter);
+            const auto last = iter->end;
+            return erase_slots([first, last](const slot_type&, std::size_t i)
             {
-                auto sp = m_Ptr.lock();
-                if (!sp)
-                {
-                    this->disconnect();
-                    return {};
-                }
+                return i >= first && i < last;
+            });
+        }
 
-                if (this->connected())
-                {
-                    return invoke_helper<function_type>::call(m_Func, sp, std::forward<Args>(args)...);
-                }
+        // Disconnect any slots that are bound to the function object.
+        // Returns the number of slots that were disconnected.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, Func, Args...>::value>,
+            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
+        std::size_t disconnect(Func&& f)
+        {
+            // Create a temporary slot for comparison.
+            auto s = slot<R(Args...)>(std::forward<Func>(f));
+            return erase(s);
+        }
 
-                return {};
-            }
+        // Disconnect any slots that are bound to the function object.
+        // Returns the number of slots that were disconnected.
+        template<typename Func, typename Ptr,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, Func, Ptr, Args...>::value>,
+            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
+        std::size_t disconnect(Func&& f, Ptr&& p)
+        {
+            // Create a temporary slot for comparison.
+            auto s = slot<R(Args...)>(std::forward<Func>(f), std::forward<Ptr>(p));
+            return erase(s);
+        }
 
-        private:
-            pointer_type m_Ptr;
-            function_type m_Func;
-        };
+        // Disconnect any slots that refer to the same callable object.
+        // Matching a slot compares the address of the object, so no temporary
+        // slot is allocated.
+        // Returns the number of slots that were disconnected.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<!std::is_reference<Func>::value>>
+        std::size_t disconnect(slot_ref<Func> f)
+        {
+            const detail::slot_func<R, slot_ref<Func>, Args...> probe(std::move(f));
+            return erase_matching(probe);
+        }
 
-        // Slot implementation for pointer to member function that automatically 
-        // tracks the lifetime of a supplied object through a weak pointer in 
-        // order to disconnect the slot on object destruction.
-        // Partial specialization for void return types.
-        template<typename Func, typename WeakPtr, typename... Args>
-        class slot_pmf_tracked<void, Func, WeakPtr, Args...> : public slot_impl<void, Args...>
+        // Disconnect any slots that are bound to the function at compile time.
+        // Matching a slot only compares its type, so no temporary slot is allocated.
+        // Returns the number of slots that were disconnected.
+        template<typename FuncT, FuncT Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, FuncT, Args...>::value>>
+        std::size_t disconnect()
         {
-        public:
-            using function_type = traits::decay_t<Func>;
-            using pointer_type = traits::decay_t<WeakPtr>;
+            const detail::slot_bound<R, FuncT, Func, Args...> probe;
+            return erase_matching(probe);
+        }
 
-            slot_pmf_tracked(const slot_pmf_tracked&) = default;
+        // Disconnect any slots that are bound to the pointer to member function
+        // at compile time and to the object.
+        // Matching a slot compares its type and its object pointer.
+        // Returns the number of slots that were disconnected.
+        template<typename FuncT, FuncT Func, typename Ptr,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, FuncT, Ptr, Args...>::value>>
+        std::size_t disconnect(Ptr&& p)
+        {
+            using bound = bound_pmf<FuncT, Func, Ptr>;
+            const typename bound::type probe(bound::pointer(std::forward<Ptr>(p)));
+            return erase_matching(probe);
+        }
 
-            slot_pmf_tracked(Func&& func, WeakPtr&& ptr)
-                : m_Ptr{ std::forward<WeakPtr>(ptr) }
-                , m_Func{ std::forward<Func>(func) }
-            {}
+#if SIG_CPP17
+        // Disconnect any slots that are bound to the function at compile time.
+        template<auto Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, decltype(Func), Args...>::value>>
+        std::size_t disconnect()
+        {
+            return disconnect<decltype(Func), Func>();
+        }
 
-            virtual bool connected() const noexcept override
-            {
-                return !m_Ptr.expired() && slot_state::connected();
-            }
+        // Disconnect any slots that are bound to the pointer to member function
+        // at compile time and to the object.
+        template<auto Func, typename Ptr,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, decltype(Func), Ptr, Args...>::value>>
+        std::size_t disconnect(Ptr&& p)
+        {
+            return disconnect<decltype(Func), Func>(std::forward<Ptr>(p));
+        }
+#endif
 
-            virtual slot_impl<void, Args...>* clone() const override
+        // The number of slots that are connected to the signal.
+        std::size_t num_slots() const
+        {
+            lock_type lock(m_SlotMutex);
+            const auto& slots = m_Slots;
+            if (!m_ExpiredSlots)
             {
-                return new slot_pmf_tracked(*this);
+                return slots.size();
             }
 
-            virtual bool equals(const slot_impl<void, Args...>* s) const override
+            // Don't count the expired tracked slots that weren't purged yet.
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < slots.size(); ++i)
             {
-                if (auto spmft = dynamic_cast<const slot_pmf_tracked*>(s))
+                if (slots[i]->connected())
                 {
-                    return try_equals<pointer_type>::equals(m_Ptr, spmft->m_Ptr) &&
-                        try_equals<function_type>::equals(m_Func, spmft->m_Func);
+                    ++count;
                 }
-
-                return false;
             }
+            return count;
+        }
 
-            virtual opt::optional<void> operator()(Args&&... args) override
-            {
-                auto sp = m_Ptr.lock();
-                if (!sp)
-                {
-                    this->disconnect();
-                }
+        bool empty() const
+        {
+            return num_slots() == 0;
+        }
 
-                if (this->connected())
-                {
-                    invoke_helper<function_type>::call(m_Func, sp, std::forward<Args>(args)...);
-                }
+        // True if none of the connected slots can throw when it is invoked.
+        // A slot can't throw if its function object (and the predicate of its
+        // filter) is noexcept. Always true for a nothrow_signal.
+        bool nothrow() const
+        {
+            lock_type lock(m_SlotMutex);
+            return m_ThrowingSlots == 0;
+        }
 
-                return {};
+        // Forward the invocation of this signal to the target signal.
+        // The slots of the target signal (and the signals that it forwards to)
+        // are invoked after the slots of this signal, and their results are
+        // passed to the combiner of this signal. The combiner of the target
+        // signal is not used.
+        // The target may be destroyed while this signal is being invoked; the
+        // slots of the target that weren't invoked yet are skipped.
+        // @throws forwarding_cycle_exception if the target (directly or indirectly)
+        // forwards to this signal.
+        void forward_to(signal& target)
+        {
+            std::lock_guard<std::mutex> graph(detail::forwarding_mutex());
+
+            if (std::find(m_Forwards.begin(), m_Forwards.end(), &target) != m_Forwards.end())
+            {
+                return;
             }
 
-        private:
-            pointer_type m_Ptr;
-            function_type m_Func;
-        };
+            if (target.forwards_to(this))
+            {
+                throw forwarding_cycle_exception();
+            }
 
-        // since C++14
-        // @see https://en.cppreference.com/w/cpp/utility/integer_sequence
-        // @see https://gist.github.com/ntessore/dc17769676fb3c6daa1f
-        // Integer sequence is used to unpack a tuple. This is required for the 
-        // slot iterator.
-        template<typename T, T... Ints>
-        struct integer_sequence
+            target.m_Sources.push_back(this);
+
+            lock_type lock(m_SlotMutex);
+            m_Forwards.push_back(&target);
+        }
+
+        // Stop forwarding the invocation of this signal to the target signal.
+        // @returns true if this signal was forwarding to the target.
+        bool stop_forwarding(signal& target)
         {
-            using value_type = T;
-            static constexpr std::size_t size()
+            std::lock_guard<std::mutex> graph(detail::forwarding_mutex());
+
+            if (!remove_forward(target.m_Sources, this))
             {
-                return sizeof...(Ints);
+                return false;
             }
-        };
 
-        template<std::size_t... Ints>
-        using index_sequence = integer_sequence<std::size_t, Ints...>;
+            lock_type lock(m_SlotMutex);
+            remove_forward(m_Forwards, &target);
+            return true;
+        }
 
-        template<typename T, std::size_t N, T... Is>
-        struct make_integer_sequence : make_integer_sequence<T, N - 1, N - 1, Is...>
-        {};
+        // Set the debug name of the signal (for example, for tracing).
+        // The string must outlive the signal (for example, a string literal).
+        void set_name(const char* name) noexcept
+        {
+            m_Name = name;
+#if SIG_SIGNAL_STATS
+            m_SlotMutex.counters().set_name(name);
+#endif
+        }
 
-        // Specialization for integer sequences of 0 length.
-        template<typename T, T... Is>
-        struct make_integer_sequence<T, 0, Is...> : integer_sequence<T, Is...>
-        {};
+        // The debug name of the signal or nullptr if it doesn't have a name.
+        const char* name() const noexcept
+        {
+            return m_Name;
+        }
 
-        template<std::size_t N>
-        using make_index_sequence = make_integer_sequence<std::size_t, N>;
+#if SIG_SIGNAL_STATS
+        // The lock and copy-on-write counters of the signal.
+        signal_stats stats() const noexcept
+        {
+            return m_SlotMutex.counters().snapshot();
+        }
+#endif
 
-        template<typename... T>
-        using index_sequence_for = make_index_sequence<sizeof...(T)>;
+        // Replace the combiner.
+        // Must not be called while the signal is being invoked.
+        void set_combiner(Combiner combiner)
+        {
+            m_Combiner = std::move(combiner);
+        }
 
-        // The slot_iterator is a wrapper for the actual container that 
-        // contains a list of slots to be invoked. When the slot_iterator
-        // is dereferenced, it must invoke the slot that is referenced by the 
-        // current internal iterator and return the result of invoking the function.
-        template<typename T, typename InputIterator, typename... Args>
-        class slot_iterator
+        // The combiner that is used to combine the results of the slots.
+        Combiner& combiner()
         {
-        public:
-            // These are required for iterators:
-            using iterator_category = std::input_iterator_tag;
-            using value_type = T;
-            using difference_type = std::ptrdiff_t;
-            using pointer = T*;
-            using reference = T&;
+            return m_Combiner;
+        }
 
-            using args_type = std::tuple<Args...>;
-            using args_sequence = make_index_sequence<sizeof...(Args)>;
+        const Combiner& combiner() const
+        {
+            return m_Combiner;
+        }
 
-            slot_iterator(InputIterator iter, args_type& args)
-                : m_Iter(iter)
-                , m_Args(args)
-            {}
+        // Invoke the signal.
+        //
+        // Invoking a signal does not allocate memory if:
+        // - the signal (directly or indirectly) forwards to at most
+        //   SIG_INLINE_FORWARDS other signals,
+        // - the slots are connected with connect, connect_extended or a filter
+        //   (free functions, function objects, and pointers to member functions
+        //   with raw or tracked pointers), and the slots themselves don't allocate,
+        // - the combiner is optional_last_value, first_engaged, first_that, any_of,
+        //   all_of, or a reduction combiner (sum_value, min_value, max_value,
+        //   mean_value) that was reserved (or invoked once) for at least the
+        //   number of slots.
+        // This holds for all slot storage policies.
+        //
+        // Invoking a signal is not lock-free. The slot mutex is locked to copy
+        // the slot list (reference count increments) and never while a slot is
+        // invoked. It is only contended while another thread connects or
+        // disconnects slots, and then the invocation waits until that thread
+        // has updated the slot list, which may copy (and allocate) the list.
+        // If slots are disconnected concurrently, the invocation may release the
+        // last reference to them and free their memory when it returns.
+        // A tracked slot whose object was destroyed is removed from the signal
+        // the next time a slot is connected or disconnected.
+        //
+        // A nothrow_signal is invoked with the noexcept specifier so that the
+        // callers don't need to handle exceptions.
+        result_type operator()(Args... args) const noexcept(detail::is_nothrow_storage<SlotStorage>::value)
+        {
+#if SIG_TRACE
+            detail::trace_scope trace(m_Name ? m_Name : "signal", "signal", this);
+#endif
+            auto t = std::tuple<Args...>(std::forward<Args>(args)...);
 
-            slot_iterator(const slot_iterator&) = default;
-            slot_iterator(slot_iterator&&) = default;
+            // Get a read-only copy of the slots.
+            // A blocked signal invokes the combiner without any slots
+            // so that combiners returning references can still return
+            // their (empty) state.
+            bool forwarding = false;
+            const auto slots = m_Blocked ? list_type() : read_slots(forwarding);
 
-            // Pre-increment operator.
-            slot_iterator& operator++()
+            if (!forwarding)
             {
-                ++m_Iter;
-                return *this;
+                using iterator = detail::slot_iterator<R, list_iterator, Args...>;
+                return m_Combiner(iterator(slots.begin(), t), iterator(slots.end(), t));
             }
 
-            // Post-increment operator
-            slot_iterator operator++(int)
-            {
-                slot_iterator tmp(*this);
-                ++m_Iter;
-                return tmp;
-            }
+            // Invoke the slots of this signal followed by the slots
+            // of the signals that this signal forwards to.
+            snapshot_list snapshots;
+            collect_slots(snapshots);
 
-            bool operator==(const slot_iterator& other) const
-            {
-                return m_Iter == other.m_Iter;
-            }
+            using iterator = detail::slot_iterator<R, detail::chain_iterator<list_type>, Args...>;
+            const auto first = snapshots.begin();
+            const auto last = snapshots.end();
+            return m_Combiner(iterator(detail::chain_iterator<list_type>(first, last), t),
+                iterator(detail::chain_iterator<list_type>(last), t));
+        }
 
-            bool operator!=(const slot_iterator& other) const
+        // Invoke the signal once for every argument set in the range [first, last).
+        // The elements of the range are std::tuple<Args...> (args_type) and the
+        // range must support multiple passes (forward iterators).
+        //
+        // The slot list is read only once. Each slot is invoked for all argument
+        // sets before the next slot is invoked (slot-major order) so the code and
+        // data of the slot stay in cache. The results are stored and combined per
+        // argument set afterwards, so combiners that return early do not prevent
+        // the slots from being invoked. Arguments that are passed by value are
+        // copied for every invocation and rvalue reference arguments are not
+        // supported.
+        //
+        // @returns The combined result for each argument set.
+        template<typename ForwardIterator>
+        std::vector<result_type> emit_batch(ForwardIterator first, ForwardIterator last) const
+        {
+#if SIG_TRACE
+            detail::trace_scope trace(m_Name ? m_Name : "signal", "signal", this);
+#endif
+            const auto count = static_cast<std::size_t>(std::distance(first, last));
+
+            // Get a read-only copy of the slots (including forwarded slots).
+            snapshot_list snapshots;
+            collect_slots(snapshots);
+            std::size_t num_slots = 0;
+            for (const auto& slots : snapshots)
             {
-                return m_Iter != other.m_Iter;
+                num_slots += slots.size();
             }
 
-            // Invoke the slot referenced by the internal iterator.
-            opt::optional<T> operator*()
+            std::vector<opt::optional<R>> results;
+            results.reserve(num_slots * count);
+            for (const auto& slots : snapshots)
             {
-                return do_invoke(args_sequence());
+                for (const auto& s : slots)
+                {
+                    auto& slot = *s;
+                    for (auto iter = first; iter != last; ++iter)
+                    {
+                        results.push_back(invoke_copy(slot, *iter, detail::index_sequence_for<Args...>()));
+                    }
+                }
             }
 
-        private:
-            template<std::size_t... Is>
-            constexpr opt::optional<T> do_invoke(index_sequence<Is...>)
+            using iterator = detail::result_iterator<R>;
+            std::vector<result_type> combined;
+            combined.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
             {
-                // Unpack tuple arguments and invoke slot.
-                return (**m_Iter)(std::forward<Args>(std::get<Is>(m_Args))...);
+                combined.push_back(m_Combiner(iterator(results.data() + i, count, 0), iterator(results.data() + i, count, num_slots)));
             }
 
-            InputIterator m_Iter;
-            args_type& m_Args;
-        };
+            return combined;
+        }
 
-        // Specialization for void return types.
-        template<typename InputIterator, typename... Args>
-        class slot_iterator<void, InputIterator, Args...>
+        // Invoke the signal once for every argument set in the batch.
+        std::vector<result_type> emit_batch(const std::vector<args_type>& batch) const
         {
-        public:
-            using iterator_category = std::input_iterator_tag;
-            using value_type = void;
-            using difference_type = std::ptrdiff_t;
-            using pointer = void;
-            using reference = void;
-
-            using args_type = std::tuple<Args...>;
-            using args_sequence = make_index_sequence<sizeof...(Args)>;
-
-            slot_iterator(InputIterator iter, args_type& args)
-                : m_Iter(iter)
-                , m_Args(args)
-            {}
-
-            slot_iterator(const slot_iterator&) = default;
-            slot_iterator(slot_iterator&&) = default;
-
-            // Pre-increment operator.
-            slot_iterator& operator++()
-            {
-                ++m_Iter;
-                return *this;
-            }
+            return emit_batch(batch.begin(), batch.end());
+        }
 
-            // Post-increment operator
-            slot_iterator operator++(int)
-            {
-                slot_iterator tmp(*this);
-                ++m_Iter;
-                return tmp;
-            }
+    private:
+        template <typename>
+        friend class slot;
+        
+        // Invoke a slot with a copy of the arguments that are passed by value.
+        // Reference arguments are passed as is.
+        template<typename Tuple, std::size_t... Is>
+        static opt::optional<R> invoke_copy(slot_type& slot, Tuple& args, detail::index_sequence<Is...>)
+        {
+            return slot(static_cast<Args>(std::get<Is>(args))...);
+        }
 
-            bool operator==(const slot_iterator& other) const
-            {
-                return m_Iter == other.m_Iter;
-            }
+        // A group bucket stores the (one past the) last index of the slots
+        // that belong to the group. The first index of the group is the end
+        // of the previous bucket (or the number of front slots).
+        struct group_bucket
+        {
+            group_type group;
+            std::size_t end;
+        };
 
-            bool operator!=(const slot_iterator& other) const
-            {
-                return m_Iter != other.m_Iter;
-            }
+        using group_list = std::vector<group_bucket>;
+        using group_iterator = typename group_list::iterator;
 
-            opt::optional<void> operator*()
-            {
-                return do_invoke(args_sequence());
-            }
+        // The slot implementation of a pointer to member function that is
+        // bound at compile time, and the pointer that the slot stores.
+        template<typename FuncT, FuncT Func, typename Ptr, bool = detail::traits::is_weak_ptr_convertable<Ptr>::value>
+        struct bound_pmf
+        {
+            using pointer_type = detail::traits::decay_t<Ptr>;
+            using type = detail::slot_bound_pmf<R, FuncT, Func, pointer_type, Args...>;
 
-        private:
-            template<std::size_t... Is>
-            constexpr opt::optional<void> do_invoke(index_sequence<Is...>)
+            static pointer_type pointer(Ptr&& p)
             {
-                // Unpack tuple arguments and invoke slot.
-                (**m_Iter)(std::forward<Args>(std::get<Is>(m_Args))...);
-                return {};
+                return std::forward<Ptr>(p);
             }
-
-            InputIterator m_Iter;
-            args_type& m_Args;
         };
 
-        // Base type for slots.
-        // This is required for signal_base to be able to pass
-        // a slot to a signal through the signal_base interface.
-        class slot_base
+        // Track the lifetime of the object through a weak pointer.
+        template<typename FuncT, FuncT Func, typename Ptr>
+        struct bound_pmf<FuncT, Func, Ptr, true>
         {
-            // The signal class needs access to the index method.
-            template<typename, typename>
-            friend class sig::signal;
-            virtual std::size_t& index() = 0;
+            using pointer_type = detail::traits::decay_t<decltype(to_weak(std::declval<Ptr>()))>;
+            using type = detail::slot_bound_pmf_tracked<R, FuncT, Func, pointer_type, Args...>;
 
-        public:
-            virtual void block() = 0;
-            virtual void unblock() = 0;
-            virtual bool connected() const noexcept = 0;
-            virtual bool blocked() const noexcept = 0;
-            virtual bool disconnect() = 0;
+            static pointer_type pointer(Ptr&& p)
+            {
+                return to_weak(std::forward<Ptr>(p));
+            }
         };
 
-        // Base type for the signal class.
-        // Allows slots to disconnect from a signal.
-        class signal_base
+        template<typename Func>
+        slot_ptr_type make_extended_slot(Func&& f)
         {
-        public:
-            virtual ~signal_base() = default;
-            virtual void remove_slot(slot_base& slot) = 0;
-        };
-
-    } // namespace detail
-
-    // Primary slot template
-    template<typename Func>
-    class slot;
-
-    // TODO: Refactor slot to derive from detail::slot_state
-    // Specialization for function objects.
-    template<typename R, typename... Args>
-    class slot<R(Args...)> : public detail::slot_base
-    {
-        using impl = detail::slot_impl<R, Args...>;
+            using extended_type = detail::slot_func_extended<R, Func, Args...>;
 
-    public:
-        // Default constructor.
-        constexpr slot() noexcept
-            : m_pImpl{ nullptr }
-            , m_pSignal{ nullptr }
-        {}
+            return slot_type::template make<extended_type, is_nothrow>(static_cast<detail::signal_base*>(this), std::forward<Func>(f));
+        }
 
-        // Slot that takes a function object.
-        template<typename Func>
-        slot(Func&& func, detail::signal_base* signal = nullptr)
-            : m_pImpl{ new detail::slot_func<R, Func, Args...>(std::forward<Func>(func)) }
-            , m_pSignal{ signal }
-        {}
+        // Add an ungrouped slot.
+        void add_slot(slot_ptr_type&& s, connect_position position)
+        {
+            lock_type lock(m_SlotMutex);
+            purge_expired();
 
-        // Slot that takes a pointer to member function or pointer to member data.
-        template<typename Func, typename Ptr>
-        slot(Func&& func, Ptr&& ptr, detail::signal_base* signal = nullptr,
-            detail::traits::enable_if_t<!detail::traits::is_weak_ptr_convertable<Ptr>::value, void*> = nullptr)
-            : m_pImpl{ new detail::slot_pmf<R, Func, Ptr, Args...>(std::forward<Func>(func), std::forward<Ptr>(ptr)) }
-            , m_pSignal{ signal }
-        {}
+            if (position == at_front)
+            {
+                insert_slot(typed_index(0, m_FrontSlots, 0, *s), std::move(s));
+                ++m_FrontSlots;
+                for (auto& g : m_Groups)
+                {
+                    ++g.end;
+                }
+            }
+            else
+            {
+                const auto first = m_Groups.empty() ? m_FrontSlots : m_Groups.back().end;
+                insert_slot(typed_index(first, m_Slots.size(), m_Slots.size(), *s), std::move(s));
+            }
+        }
 
-        template<typename Func, typename Ptr>
-        slot(Func&& func, Ptr&& ptr, detail::signal_base* signal = nullptr,
-            detail::traits::enable_if_t<detail::traits::is_weak_ptr_convertable<Ptr>::value, void*> = nullptr)
-            : m_pImpl{ new detail::slot_pmf_tracked<R, Func, decltype(to_weak(std::forward<Ptr>(ptr))), Args...>(std::forward<Func>(func), to_weak(std::forward<Ptr>(ptr))) }
-            , m_pSignal{ signal }
-        {}
+        // Add a slot to a group.
+        void add_slot(slot_ptr_type&& s, group_type group, connect_position position)
+        {
+            lock_type lock(m_SlotMutex);
+            purge_expired();
 
-        // Copy constructor.
-        slot(const slot& copy, detail::signal_base* signal = nullptr)
-            : m_pImpl{ copy.m_pImpl->clone() }
-            , m_pSignal{ signal ? signal : copy.m_pSignal }
-        {}
+            auto iter = find_group(group);
+            if (iter == m_Groups.end() || iter->group != group)
+            {
+                iter = m_Groups.insert(iter, group_bucket{ group, group_begin(iter) });
+            }
 
-        // Explicit parameterized constructor.
-        explicit slot(std::unique_ptr<impl> pImpl)
-            : m_pImpl{ pImpl }
-            , m_pSignal{ nullptr }
-        {}
+            const auto first = group_begin(iter);
+            const auto index = typed_index(first, iter->end, position == at_front ? first : iter->end, *s);
+            for (; iter != m_Groups.end(); ++iter)
+            {
+                ++iter->end;
+            }
 
-        // Move constructor.
-        slot(slot&& other)
-            : m_pImpl{ std::move(other.m_pImpl) }
-            , m_pSignal{ other.m_pSignal }
-        {
-            other.m_pSignal = nullptr;
+            insert_slot(index, std::move(s));
         }
 
-        // Assignment operator.
-        slot& operator=(const slot& other)
+        // The index to insert a slot at in the range [first, last) of its group.
+        // If the slots are grouped by type, the slot is inserted after the last
+        // slot of the same type in the range (if any) instead of at index.
+        std::size_t typed_index(std::size_t first, std::size_t last, std::size_t index, const slot_type& s) const
         {
-            if (&other != this)
+            if (!is_type_grouped || !s.m_pImpl)
             {
-                m_pImpl.swap(other.m_pImpl->clone());
-                m_pSignal = other.m_pSignal;
+                return index;
             }
-            return *this;
+
+            const auto& type = typeid(*s.m_pImpl);
+            const auto& slots = m_Slots;
+            for (auto i = last; i > first; --i)
+            {
+                const auto& other = *slots[i - 1];
+                if (other.m_pImpl && typeid(*other.m_pImpl) == type)
+                {
+                    return i;
+                }
+            }
+            return index;
         }
 
-        // Move assignment operator.
-        slot& operator=(slot&& other) noexcept
+        // Binary search for the bucket of a group.
+        // Returns the first bucket that is not ordered before the group.
+        group_iterator find_group(group_type group)
         {
-            m_pImpl = std::move(other.m_pImpl);
-            m_pSignal = other.m_pSignal;
-            other.m_pSignal = nullptr;
-
-            return *this;
+            return std::lower_bound(m_Groups.begin(), m_Groups.end(), group,
+                [](const group_bucket& g, group_type value) { return g.group < value; });
         }
 
-        // Explicit conversion to bool.
-        explicit operator bool() const
+        // The index of the first slot in a group.
+        std::size_t group_begin(group_iterator iter) const
         {
-            return m_pImpl != nullptr;
+            return iter == m_Groups.begin() ? m_FrontSlots : (iter - 1)->end;
         }
 
-        // Equality operator
-        friend bool operator==(const slot& s1, const slot& s2)
+        // Remove buckets that no longer contain any slots.
+        void remove_empty_groups()
         {
-            if (!s1 || !s2)
+            auto first = m_FrontSlots;
+            auto iter = m_Groups.begin();
+            while (iter != m_Groups.end())
             {
-                return !s1 && !s2;
+                if (iter->end == first)
+                {
+                    iter = m_Groups.erase(iter);
+                }
+                else
+                {
+                    first = iter->end;
+                    ++iter;
+                }
             }
-
-            return s1.m_pImpl->equals(s2.m_pImpl.get());
         }
 
-        // Inequality operator
-        friend bool operator!=(const slot& s1, const slot& s2)
+        // The slots don't store their position in the slot list, which would
+        // have to be updated for all of the following slots when a slot is
+        // inserted or erased. Instead, every slot has a key (its index) that
+        // increases with its position, so the position of a slot is found with
+        // a binary search. A slot takes the key in the middle of the keys of
+        // its neighbors. The keys are only reassigned when there is no key left
+        // between the neighbors.
+        static constexpr std::size_t key_step = std::size_t(1) << (sizeof(std::size_t) * 4);
+        static constexpr std::size_t max_key = static_cast<std::size_t>(-1);
+
+        // Insert a slot at the given index.
+        // The order of the other slots is preserved.
+        void insert_slot(std::size_t index, slot_ptr_type&& s)
         {
-            return !(s1 == s2);
-        }
+            std::size_t key;
+            if (!free_key(index, key))
+            {
+                key = reassign_keys(index);
+            }
+            s->index() = key;
 
-        bool connected() const noexcept
-        {
-            return m_pImpl && m_pImpl->connected();
+            if (may_throw(*s))
+            {
+                ++m_ThrowingSlots;
+            }
+            m_Slots.insert(index, std::move(s));
+#if SIG_SIGNAL_STATS
+            m_SlotMutex.counters().update_peak(m_Slots.size());
+#endif
         }
 
-        bool disconnect() noexcept
+        // Find a key between the keys of the slots before and at the index.
+        // The slots are accessed through a const reference to the slot list so
+        // that the list isn't copied if it is shared with an invocation.
+        bool free_key(std::size_t index, std::size_t& key) const
         {
-            if (m_pImpl && m_pSignal && m_pImpl->disconnect() )
+            const auto& slots = m_Slots;
+            if (slots.empty())
             {
-                m_pSignal->remove_slot(*this);
+                key = max_key / 2;
                 return true;
             }
 
-            return false;
+            if (index == slots.size())
+            {
+                const auto prev = slots[index - 1]->index();
+                key = prev + key_step;
+                return max_key - prev >= key_step;
+            }
+
+            const auto next = slots[index]->index();
+            if (index == 0)
+            {
+                key = next - key_step;
+                return next >= key_step;
+            }
+
+            const auto prev = slots[index - 1]->index();
+            key = prev + (next - prev) / 2;
+            return next - prev >= 2;
         }
 
-        bool blocked() const noexcept
+        // Spread the keys of the slots evenly, leaving out the key of a
+        // slot that is inserted at the index.
+        // @returns The key of the inserted slot.
+        std::size_t reassign_keys(std::size_t index)
         {
-            return m_pImpl && m_pImpl->blocked();
+            const auto& slots = m_Slots;
+            const auto step = max_key / (slots.size() + 2);
+            auto key = step;
+            for (auto iter = slots.begin(); iter != slots.end(); ++iter, key += step)
+            {
+                if (key == step * (index + 1))
+                {
+                    key += step;
+                }
+                (*iter)->index() = key;
+            }
+            return step * (index + 1);
         }
 
-        void block() noexcept
+        // The index of the first slot whose key is not less than the key.
+        std::size_t find_slot(std::size_t key) const
         {
-            if (m_pImpl)
-                m_pImpl->block();
+            const auto& slots = m_Slots;
+            std::size_t first = 0;
+            std::size_t count = slots.size();
+            while (count > 0)
+            {
+                const auto half = count / 2;
+                if (slots[first + half]->index() < key)
+                {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else
+                {
+                    count = half;
+                }
+            }
+            return first;
         }
 
-        void unblock() noexcept
+        // True if invoking the slot may throw.
+        static bool may_throw(const slot_type& s) noexcept
         {
-            if (m_pImpl)
-                m_pImpl->unblock();
+            return s.m_pImpl && !s.m_pImpl->nothrow();
         }
 
-        // Invoke the slot.
-        opt::optional<R> operator()(Args&&... args)
+        // Remove a slot from the signal.
+        virtual void remove_slot(detail::slot_base& slot) override
         {
-            if (!blocked() && connected())
+            lock_type lock(m_SlotMutex);
+            purge_expired();
+            const auto i = find_slot(slot.index());
+            const auto& slots = m_Slots;
+
+            // The slot may have already been removed by disconnecting
+            // an equivalent slot.
+            if (i < slots.size() && slots[i].get() == &slot)
             {
-                return (*m_pImpl)(std::forward<Args>(args)...);
+                erase_slot(i);
+            }
+        }
+
+        // Erase the slot at index i.
+        // The order of the remaining slots is preserved.
+        void erase_slot(std::size_t i)
+        {
+            const auto& slots = m_Slots;
+            if (may_throw(*slots[i]))
+            {
+                --m_ThrowingSlots;
             }
+            m_Slots.erase(i);
 
-            return {};
+            if (i < m_FrontSlots)
+            {
+                --m_FrontSlots;
+            }
+
+            for (auto& g : m_Groups)
+            {
+                if (g.end > i)
+                {
+                    --g.end;
+                }
+            }
+
+            remove_empty_groups();
         }
 
-    private:
-        // Signals need to access the state of the slots.
-        template<typename, typename>
-        friend class signal;
+        // Erase all slots that satisfy the predicate.
+        // The order of the remaining slots is preserved.
+        // @param pred Predicate that takes the slot and the index of the slot.
+        // @returns The number of slots that were erased.
+        template<typename Pred>
+        std::size_t erase_slots(Pred pred)
+        {
+            const auto size = m_Slots.size();
+            const auto front = m_FrontSlots;
+            auto group = m_Groups.begin();
 
-        virtual std::size_t& index() override
+            std::size_t count = 0;  // The number of slots that were removed.
+
+            // Move the group boundaries that end at slot i.
+            auto move_boundaries = [&](std::size_t i)
+            {
+                if (i == front)
+                {
+                    m_FrontSlots -= count;
+                }
+                for (; group != m_Groups.end() && group->end == i; ++group)
+                {
+                    group->end -= count;
+                }
+            };
+
+            // The slot list only copies the parts that contain removed slots.
+            m_Slots.erase_if([&](const slot_ptr_type& s, std::size_t i)
+            {
+                move_boundaries(i);
+                if (pred(*s, i))
+                {
+                    s->state().disconnect();
+                    if (may_throw(*s))
+                    {
+                        --m_ThrowingSlots;
+                    }
+                    ++count;
+                    return true;
+                }
+
+                return false;
+            });
+            move_boundaries(size);
+
+            remove_empty_groups();
+
+            return count;
+        }
+
+        // Remove the tracked slots whose object was destroyed if an invocation
+        // found one since the last purge. The slot mutex must be locked.
+        void purge_expired()
         {
-            return m_pImpl->index();
+            if (m_ExpiredSlots.exchange(false))
+            {
+                erase_slots([](const slot_type& s, std::size_t)
+                {
+                    return !s.connected();
+                });
+            }
         }
 
-        // Query the state of the slot.
-        constexpr detail::slot_state& state()
+        // Set by a slot that found that its tracked object was destroyed.
+        virtual void slot_expired() noexcept override
         {
-            return *m_pImpl;
+            m_ExpiredSlots = true;
         }
 
-        std::unique_ptr<impl> m_pImpl;              // Pointer to implementation
-        detail::signal_base* m_pSignal;             // The signal this slot belongs to.
-    };
+        // Erase all slots that match given slot.
+        // @param slot The slot to match for erasure.
+        // @returns The number of slots that were actually erased.
+        template<typename Func>
+        size_t erase(const slot<Func>& slot)
+        {
+            lock_type lock(m_SlotMutex);
+            purge_expired();
 
-    // Shared pointer to a slot.
-    using slot_ptr = std::shared_ptr<detail::slot_base>;
+            // Comparing the slots may throw a not_comparable_exception.
+            // Keep the remaining slots and rethrow the exception after
+            // the slot list has been compacted.
+            std::exception_ptr error;
+            auto count = erase_slots([&slot, &error](const slot_type& s, std::size_t)
+            {
+                if (error) return false;
 
-    // Weak pointer to a slot.
-    using slot_wptr = std::weak_ptr<detail::slot_base>;
+                try
+                {
+                    return s == slot;
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                    return false;
+                }
+            });
 
-    /**
-     * An RAII object that blocks connections until destruction.
-     */
-    class connection_blocker
-    {
-    public:
-        using slot_type = slot_wptr;
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
 
-        connection_blocker() noexcept = default;
-        ~connection_blocker() noexcept
-        {
-            release();
+            return count;
         }
 
-        connection_blocker(const connection_blocker&) noexcept = delete;
-        connection_blocker(connection_blocker&& c) noexcept
-            : m_Slot{ std::move(c.m_Slot) }
-        {}
-
-        connection_blocker& operator=(const connection_blocker&) = delete;
-        connection_blocker& operator=(connection_blocker&& c) noexcept
+        // Erase all slots whose implementation is equal to the given one.
+        // Only slots of the same type as the probe compare their members, so
+        // this never throws a not_comparable_exception if the members of the
+        // probe are comparable (like bound slots and slot_refs).
+        // @returns The number of slots that were actually erased.
+        std::size_t erase_matching(const detail::slot_impl<R, Args...>& probe)
         {
-            release();
-            m_Slot = std::move(c.m_Slot);
-            return *this;
+            lock_type lock(m_SlotMutex);
+            purge_expired();
+            return erase_slots([&probe](const slot_type& s, std::size_t)
+            {
+                return s.m_pImpl && s.m_pImpl->equals(&probe);
+            });
         }
 
-        void swap(connection_blocker& other) noexcept
+        void clear()
         {
-            std::swap(m_Slot, other.m_Slot);
+            lock_type lock(m_SlotMutex);
+            m_Slots.clear();
+            m_Groups.clear();
+            m_FrontSlots = 0;
+            m_ThrowingSlots = 0;
         }
 
-    private:
-        friend class connection;
+        // Get a copy of the slots for reading.
+        // Inline slot lists are copied, heap slot lists are shared.
+        // Also copies the signals that this signal forwards to.
+        // Get a copy of the slots and whether this signal forwards to other signals.
+        const list_type read_slots(bool& forwarding) const
+        {
+            lock_type lock(m_SlotMutex);
+            forwarding = !m_Forwards.empty();
+            return m_Slots;
+        }
 
-        explicit connection_blocker(slot_type slot) noexcept
-            : m_Slot{ std::move(slot) }
+        // Collect copies of the slots of this signal and the signals that it
+        // forwards to. The slots of a target are copied while the slot mutex
+        // of its source is locked, so the target can't be destroyed while it
+        // is read (the destructor of the target locks the slot mutex of each
+        // source). The graph has no cycles, so the mutexes are always locked
+        // from the sources to the targets.
+        void collect_slots(snapshot_list& snapshots) const
         {
-            if (auto s = m_Slot.lock())
+            if (m_Blocked) return;
+
+            lock_type lock(m_SlotMutex);
+            snapshots.push_back(list_type(m_Slots));
+
+            for (auto target : m_Forwards)
             {
-                s->block();
+                target->collect_slots(snapshots);
             }
         }
 
-        void release() noexcept
+        // Returns true if this signal is the target or (indirectly) forwards to it.
+        // Must be called with the forwarding mutex locked.
+        bool forwards_to(const signal* target) const
         {
-            if (auto s = m_Slot.lock())
+            if (this == target) return true;
+
+            for (auto forward : m_Forwards)
             {
-                s->unblock();
+                if (forward->forwards_to(target)) return true;
             }
+
+            return false;
         }
 
-        slot_type m_Slot;
-    };
+        static bool remove_forward(std::vector<signal*>& signals, signal* s)
+        {
+            auto iter = std::find(signals.begin(), signals.end(), s);
+            if (iter == signals.end()) return false;
 
-    inline void swap(connection_blocker& cb1, connection_blocker& cb2) noexcept
-    {
-        cb1.swap(cb2);
-    }
+            signals.erase(iter);
+            return true;
+        }
 
-    /**
-     * Connection object allows for managing slot connections.
-     */
-    class connection
+        // The combiner is invoked from the const function call operator.
+        // Stateful combiners that are used by multiple threads at the same
+        // time must be wrapped in sig::per_thread. The built-in combiners
+        // don't keep state between invocations.
+        mutable Combiner m_Combiner;
+#if SIG_SIGNAL_STATS
+        mutable mutex_type m_SlotMutex{ this };
+#else
+        mutable mutex_type m_SlotMutex;
+#endif
+        list_type m_Slots;
+        group_list m_Groups;            // Sorted group buckets.
+        std::size_t m_FrontSlots;       // The number of ungrouped slots connected at_front.
+        std::size_t m_ThrowingSlots;    // The number of slots that may throw.
+        std::vector<signal*> m_Forwards;    // Signals that this signal forwards to.
+        std::vector<signal*> m_Sources;     // Signals that forward to this signal.
+        const char* m_Name;                 // Debug name.
+        std::atomic_bool m_Blocked;
+        std::atomic_bool m_ExpiredSlots;    // True if a tracked slot expired since the last purge.
+    };
+
+    // A signal that dispatches to the slots that are connected to a key.
+    //
+    // Slots are connected to a key (for example, a topic or an instrument ID)
+    // or to all keys (wildcard slots). Invoking the signal for a key only
+    // invokes the slots of that key followed by the wildcard slots.
+    //
+    // The keys are stored in a flat open-addressing hash table that maps a key
+    // to the index of an entry that holds the slot list of the key. Like the
+    // signal class, the slot list of a key is copied (or shared if it is stored
+    // on the heap) before the slots are invoked so that slots may be connected
+    // or disconnected while the signal is being invoked. Entries are not removed
+    // when all of the slots of a key are disconnected.
+    template<typename Key, typename Func, typename Combiner = optional_last_value<typename detail::traits::function_traits<Func>::result_type>,
+        typename Hash = std::hash<Key>>
+    class keyed_signal;
+
+    template<typename Key, typename R, typename... Args, typename Combiner, typename Hash>
+    class keyed_signal<Key, R(Args...), Combiner, Hash> : detail::signal_base
     {
     public:
-        using slot_type = slot_wptr;
+        using key_type = Key;
+        using slot_type = slot<R(Args...)>;
+        using slot_ptr_type = std::shared_ptr<slot_type>;
+        using list_type = detail::slot_list<slot_ptr_type, SIG_INLINE_SLOTS>;
+        using mutex_type = std::mutex;
+        using lock_type = std::unique_lock<mutex_type>;
+        using result_type = typename Combiner::result_type;
 
-        connection() noexcept = default;
-        virtual ~connection() = default;
+        keyed_signal()
+            : m_Table(16, npos)
+            , m_NumSlots(0)
+            , m_ExpiredSlots(false)
+        {}
 
-        connection(const connection&) noexcept = default;
-        connection(connection&&) noexcept = default;
-        connection& operator=(const connection&) noexcept = default;
-        connection& operator=(connection&&) noexcept = default;
+        explicit keyed_signal(Combiner combiner)
+            : m_Combiner(std::move(combiner))
+            , m_Table(16, npos)
+            , m_NumSlots(0)
+            , m_ExpiredSlots(false)
+        {}
 
-        bool valid() const noexcept
+        ~keyed_signal() = default;
+
+        // Not copyable.
+        keyed_signal(const keyed_signal&) = delete;
+        keyed_signal& operator=(const keyed_signal&) = delete;
+
+        // Not moveable. Slots keep a pointer to the signal.
+        keyed_signal(keyed_signal&&) = delete;
+        keyed_signal& operator=(keyed_signal&&) = delete;
+
+        // Connect a callable function object to a key.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Args...>::value>>
+        connection connect(const key_type& key, Func&& f)
         {
-            return !m_Slot.expired();
+            auto s = slot_type::make_func(static_cast<detail::signal_base*>(this), std::forward<Func>(f));
+            connection c(s);
+            add_slot(&key, std::move(s));
+            return c;
         }
 
-        bool connected() const noexcept
+        // Connect a pointer to member function or pointer to member data to a key.
+        template<typename Func, typename Ptr,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Ptr, Args...>::value>>
+        connection connect(const key_type& key, Func&& f, Ptr&& p)
         {
-            const auto s = m_Slot.lock();
-            return s && s->connected();
+            auto s = slot_type::make_func(static_cast<detail::signal_base*>(this), std::forward<Func>(f), std::forward<Ptr>(p));
+            connection c(s);
+            add_slot(&key, std::move(s));
+            return c;
         }
 
-        bool disconnect() noexcept
+        // Connect a callable function object that is invoked for every key.
+        template<typename Func,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Args...>::value>>
+        connection connect_any(Func&& f)
         {
-            auto s = m_Slot.lock();
-            return s && s->disconnect();
+            auto s = slot_type::make_func(static_cast<detail::signal_base*>(this), std::forward<Func>(f));
+            connection c(s);
+            add_slot(nullptr, std::move(s));
+            return c;
         }
 
-        bool blocked() const noexcept
+        // Connect a pointer to member function or pointer to member data
+        // that is invoked for every key.
+        template<typename Func, typename Ptr,
+            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Ptr, Args...>::value>>
+        connection connect_any(Func&& f, Ptr&& p)
         {
-            const auto s = m_Slot.lock();
-            return s && s->blocked();
+            auto s = slot_type::make_func(static_cast<detail::signal_base*>(this), std::forward<Func>(f), std::forward<Ptr>(p));
+            connection c(s);
+            add_slot(nullptr, std::move(s));
+            return c;
         }
 
-        void block() noexcept
+        // Disconnect all slots that are connected to the key.
+        // Returns the number of slots that were disconnected.
+        std::size_t disconnect(const key_type& key)
         {
-            if (auto s = m_Slot.lock())
+            lock_type lock(m_SlotMutex);
+            purge_expired();
+
+            const auto id = find(key);
+            if (id == npos) return 0;
+
+            auto& slots = m_Entries[id].slots;
+            const auto count = slots.size();
+            for (std::size_t i = 0; i < count; ++i)
             {
-                s->block();
+                slots[i]->state().disconnect();
             }
+            slots.clear();
+            m_NumSlots -= count;
+
+            return count;
         }
 
-        void unblock() noexcept
+        // The total number of slots (including wildcard slots).
+        std::size_t num_slots() const
         {
-            if (auto s = m_Slot.lock())
+            lock_type lock(m_SlotMutex);
+            if (!m_ExpiredSlots)
             {
-                s->unblock();
+                return m_NumSlots;
             }
+
+            // Don't count the expired tracked slots that weren't purged yet.
+            auto count = connected_slots(m_Any);
+            for (const auto& e : m_Entries)
+            {
+                count += connected_slots(e.slots);
+            }
+            return count;
         }
 
-        connection_blocker blocker() const noexcept
+        // The number of slots that are connected to the key (excluding wildcard slots).
+        std::size_t num_slots(const key_type& key) const
         {
-            return connection_blocker(m_Slot);
+            lock_type lock(m_SlotMutex);
+            const auto id = find(key);
+            if (id == npos)
+            {
+                return 0;
+            }
+            return m_ExpiredSlots ? connected_slots(m_Entries[id].slots) : m_Entries[id].slots.size();
         }
 
-        void swap(connection& other) noexcept
+        // The number of keys that have (or had) slots connected.
+        std::size_t num_keys() const
         {
-            std::swap(m_Slot, other.m_Slot);
+            lock_type lock(m_SlotMutex);
+            return m_Entries.size();
         }
 
-    protected:
-        template<typename, typename>
-        friend class signal;
+        bool empty() const
+        {
+            return num_slots() == 0;
+        }
 
-        friend class scoped_connection;
+        Combiner& combiner()
+        {
+            return m_Combiner;
+        }
 
-        explicit connection(slot_type&& s) noexcept
-            : m_Slot{ std::move(s) }
-        {}
+        const Combiner& combiner() const
+        {
+            return m_Combiner;
+        }
 
-        slot_type m_Slot;
-    };
+        // Invoke the slots that are connected to the key followed by the wildcard slots.
+        result_type operator()(const key_type& key, Args... args) const
+        {
+            auto t = std::tuple<Args...>(std::forward<Args>(args)...);
 
-    inline void swap(connection& c1, connection& c2)
-    {
-        c1.swap(c2);
-    }
-    
+            // Get a read-only copy of the slots.
+            list_type slots;
+            list_type any;
+            {
+                lock_type lock(m_SlotMutex);
+                const auto id = find(key);
+                if (id != npos)
+                {
+                    slots = m_Entries[id].slots;
+                }
+                any = m_Any;
+            }
 
-    /**
-     * An RAII version of connection which disconnects it's slot on destruction.
-     */
-    class scoped_connection : public connection
-    {
-    public:
-        using base = connection;
-        using slot_type = slot_wptr;
+            using iterator = detail::slot_iterator<R, detail::concat_iterator<slot_ptr_type>, Args...>;
+            using concat = detail::concat_iterator<slot_ptr_type>;
+            return m_Combiner(iterator(concat(slots.begin(), slots.end(), any.begin()), t), iterator(concat(any.end()), t));
+        }
 
-        scoped_connection() = default;
-        virtual ~scoped_connection() override
+    private:
+        enum : std::size_t
         {
-            this->disconnect();
-        }
+            any_id = static_cast<std::size_t>(-1), // The index of the entry of the wildcard slots.
+            npos = static_cast<std::size_t>(-1),   // An empty bucket in the hash table.
+        };
 
-        scoped_connection(const base& c) noexcept
-            : base(c)
-        {}
+        struct entry
+        {
+            key_type key;
+            list_type slots;
+        };
 
-        scoped_connection(base&& c) noexcept
-            : base(std::move(c))
-        {}
+        // Add a slot to the key or to the wildcard slots if key is nullptr.
+        // The index of the slot stores the entry it belongs to.
+        void add_slot(const key_type* key, slot_ptr_type&& s)
+        {
+            lock_type lock(m_SlotMutex);
+            purge_expired();
 
-        scoped_connection(const scoped_connection&) noexcept = delete;
+            if (key)
+            {
+                const auto id = find_or_insert(*key);
+                s->index() = id;
+                m_Entries[id].slots.push_back(std::move(s));
+            }
+            else
+            {
+                s->index() = any_id;
+                m_Any.push_back(std::move(s));
+            }
 
-        scoped_connection(scoped_connection&& s) noexcept
-            : base(std::move(s.m_Slot))
-        {}
+            ++m_NumSlots;
+        }
 
-        scoped_connection& operator=(const scoped_connection&) noexcept = delete;
+        // Remove a slot from the signal.
+        virtual void remove_slot(detail::slot_base& slot) override
+        {
+            lock_type lock(m_SlotMutex);
+            purge_expired();
 
-        scoped_connection& operator=(scoped_connection&& c) noexcept
+            const auto id = slot.index();
+            auto& slots = id == any_id ? m_Any : m_Entries[id].slots;
+            const auto size = slots.size();
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                if (slots[i].get() == &slot)
+                {
+                    slots.erase(i);
+                    --m_NumSlots;
+                    return;
+                }
+            }
+        }
+
+        // Remove the tracked slots whose object was destroyed if an invocation
+        // found one since the last purge. The slot mutex must be locked.
+        void purge_expired()
         {
-            this->disconnect();
-            this->m_Slot = std::move(c.m_Slot);
-            return *this;
+            if (!m_ExpiredSlots.exchange(false))
+            {
+                return;
+            }
+
+            auto expired = [](const slot_ptr_type& s, std::size_t)
+            {
+                return !s->connected();
+            };
+
+            m_NumSlots -= m_Any.erase_if(expired);
+            for (auto& e : m_Entries)
+            {
+                m_NumSlots -= e.slots.erase_if(expired);
+            }
         }
 
-        connection release()
+        // Set by a slot that found that its tracked object was destroyed.
+        virtual void slot_expired() noexcept override
         {
-            return connection(std::move(this->m_Slot));
+            m_ExpiredSlots = true;
         }
 
-    private:
-        explicit scoped_connection(slot_type s) noexcept
-            : base(std::move(s))
-        {}
-    };
+        static std::size_t connected_slots(const list_type& slots)
+        {
+            std::size_t count = 0;
+            for (const auto& s : slots)
+            {
+                if (s->connected())
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
 
-    inline void swap(scoped_connection& c1, scoped_connection& c2)
-    {
-        c1.swap(c2);
-    }
+        std::size_t bucket(const key_type& key) const
+        {
+            return Hash()(key) & (m_Table.size() - 1);
+        }
 
-    // Default combiner for signals returns an optional value.
-    // The combiner just returns the result of the last connected slot.
-    // If no slots or functions returns void, a disengaged optional is returned.
-    template<typename T>
-    class optional_last_value
-    {
-    public:
-        using result_type = opt::optional<T>;
+        // Find the entry of the key. Returns npos if the key was not found.
+        std::size_t find(const key_type& key) const
+        {
+            for (auto b = bucket(key); ; b = (b + 1) & (m_Table.size() - 1))
+            {
+                const auto id = m_Table[b];
+                if (id == npos || m_Entries[id].key == key)
+                {
+                    return id;
+                }
+            }
+        }
 
-        template<typename InputIterator>
-        result_type operator()(InputIterator first, InputIterator last) const
+        std::size_t find_or_insert(const key_type& key)
         {
-            result_type result;
-            while (first != last)
+            auto id = find(key);
+            if (id != npos) return id;
+
+            // Keep the load factor of the table below 0.5.
+            if ((m_Entries.size() + 1) * 2 > m_Table.size())
             {
-                result_type temp = *first;
-                if (temp)   // Skip disengaged results.
-                    result = temp;
-                ++first;
+                rehash(m_Table.size() * 2);
+            }
+
+            id = m_Entries.size();
+            m_Entries.push_back(entry{ key, list_type() });
+            insert(key, id);
+
+            return id;
+        }
+
+        void insert(const key_type& key, std::size_t id)
+        {
+            auto b = bucket(key);
+            while (m_Table[b] != npos)
+            {
+                b = (b + 1) & (m_Table.size() - 1);
             }
+            m_Table[b] = id;
+        }
 
-            return result;
+        void rehash(std::size_t size)
+        {
+            m_Table.assign(size, npos);
+            for (std::size_t id = 0; id < m_Entries.size(); ++id)
+            {
+                insert(m_Entries[id].key, id);
+            }
         }
+
+        mutable Combiner m_Combiner;
+        mutable mutex_type m_SlotMutex;
+        std::vector<entry> m_Entries;       // The slots of each key.
+        std::vector<std::size_t> m_Table;   // Open-addressing hash table of entry indices.
+        list_type m_Any;                    // The wildcard slots.
+        std::size_t m_NumSlots;             // The total number of slots.
+        std::atomic_bool m_ExpiredSlots;    // True if a tracked slot expired since the last purge.
     };
 
-    // Primary template for the signal.
-    template<typename Func, typename Combiner = optional_last_value<typename detail::traits::function_traits<Func>::result_type>>
-    class signal;
+    namespace detail
+    {
+        // Hint the processor to load the cache line that contains the address.
+        inline void prefetch(const void* p) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(p);
+#elif defined(SIG_SSE2)
+            _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+            (void)p;
+#endif
+        }
+    }
 
-    // Partial specialization taking a callable.
-    template<typename R, typename... Args, typename Combiner>
-    class signal<R(Args...), Combiner> : detail::signal_base
+    // A signal that broadcasts to a very large number of slots of the same type.
+    //
+    // The slots are stored by value in chunks of ChunkSize slots, so invoking
+    // the signal is a loop over contiguous memory without virtual calls or
+    // pointers to follow. The slots that are ahead of the invoked slot are
+    // prefetched (see SIG_PREFETCH_DISTANCE).
+    //
+    // The order of the slots is not preserved: disconnecting a slot moves the
+    // last slot into its place. Slots are identified by a slot_id instead of
+    // a connection, and the results of the slots are ignored.
+    //
+    // The slot list is not copied when the signal is invoked. Instead, slots
+    // that are connected or disconnected while the signal is being invoked
+    // (from a slot or from another thread) are added or removed when the last
+    // invocation returns. A slot that is disconnected during an invocation may
+    // still be invoked by that invocation.
+    template<typename Func, typename Slot, std::size_t ChunkSize = 1024>
+    class fanout_signal;
+
+    template<typename... Args, typename Slot, std::size_t ChunkSize>
+    class fanout_signal<void(Args...), Slot, ChunkSize>
     {
     public:
-        using slot_type = slot<R(Args...)>;
-        using slot_ptr_type = std::shared_ptr<slot_type>;
-        using list_type = std::vector<slot_ptr_type>;
-        using list_iterator = typename list_type::const_iterator;
-        using cow_type = detail::cow_ptr<list_type>;
+        using slot_type = Slot;
         using mutex_type = std::mutex;
         using lock_type = std::unique_lock<mutex_type>;
-        using result_type = typename Combiner::result_type;
 
-        signal()
-            : m_Blocked(false)
-            , m_Slots(new list_type())
-        {}
-        ~signal() = default;
+        static_assert(detail::traits::is_invocable<Slot&, Args&...>::value, "The slots of a fanout_signal must be invocable with the arguments of the signal.");
+        static_assert(std::is_nothrow_move_constructible<Slot>::value, "The slots of a fanout_signal must be nothrow move constructible.");
+        static_assert(ChunkSize > 0, "The chunks of a fanout_signal must store at least 1 slot.");
 
-        // Not copyable.
-        signal(const signal&) = delete;
-        // Not copy assignable.
-        signal& operator=(const signal&) = delete;
+        static constexpr std::size_t chunk_size = ChunkSize;
 
-        // Moveable.
-        signal(signal&& other) noexcept
-            : m_Blocked(other.m_Blocked.load())
+        // Identifies a connected slot.
+        // An identifier is no longer valid once its slot is disconnected.
+        struct slot_id
         {
-            lock_type lock(other.m_SlotMutex);
-            m_Slots = std::move(other.m_Slots);
+            std::size_t index;
+            std::size_t generation;
+
+            bool operator==(const slot_id& other) const noexcept
+            {
+                return index == other.index && generation == other.generation;
+            }
+
+            bool operator!=(const slot_id& other) const noexcept
+            {
+                return !(*this == other);
+            }
+        };
+
+        fanout_signal() noexcept
+            : m_Size(0)
+            , m_NumSlots(0)
+            , m_Invocations(0)
+        {}
+
+        ~fanout_signal()
+        {
+            destroy_slots();
         }
 
-        // Move assignable.
-        signal& operator=(signal&& other) noexcept
+        // Not copyable.
+        fanout_signal(const fanout_signal&) = delete;
+        fanout_signal& operator=(const fanout_signal&) = delete;
+
+        // Not moveable. Invocations refer to the slots of the signal.
+        fanout_signal(fanout_signal&&) = delete;
+        fanout_signal& operator=(fanout_signal&&) = delete;
+
+        // Construct a slot in place from the arguments.
+        template<typename... SlotArgs>
+        slot_id emplace(SlotArgs&&... args)
         {
-            lock_type lock1(m_SlotMutex, std::defer_lock);
-            lock_type lock2(other.m_SlotMutex, std::defer_lock);
-            std::lock(lock1, lock2);
+            lock_type lock(m_Mutex);
 
-            m_Slots = std::move(other.m_Slots);
-            m_Blocked = other.m_Blocked.load();
+            // Everything that may throw is done before the identifier is
+            // allocated, or undone if it throws after.
+            std::size_t index;
+            if (m_Invocations > 0)
+            {
+                std::unique_ptr<pending_slot> p(new pending_slot{ npos, Slot(std::forward<SlotArgs>(args)...) });
+                reserve_slots(m_Size + m_PendingConnects.size() + 1);
+                reserve(m_PendingConnects, m_PendingConnects.size() + 1);
+                index = allocate_id();
+                p->index = index;
+                m_Entries[index].position = pending;
+                m_PendingConnects.push_back(std::move(p));
+            }
+            else
+            {
+                reserve(m_FreeIds, m_FreeIds.size() + 1);
+                index = allocate_id();
+                try
+                {
+                    push_slot(std::forward<SlotArgs>(args)...);
+                }
+                catch (...)
+                {
+                    free_id(index);
+                    throw;
+                }
+                m_Entries[index].position = m_Size - 1;
+                m_Ids.push_back(index);
+            }
+
+            ++m_NumSlots;
+            return slot_id{ index, m_Entries[index].generation };
         }
 
-        // Connect a previously created slot
-        connection connect(const slot_type& slot)
+        slot_id connect(const Slot& s)
         {
-            auto s = slot_ptr_type(new slot_type(slot, static_cast<detail::signal_base*>(this)));
-            connection c(s);
-            add_slot(std::move(s));
-            return c;
+            return emplace(s);
         }
 
-        // Connect a slot with a callable function object.
-        template<typename Func,
-            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Args...>::value>,
-            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
-        connection connect(Func&& f)
+        slot_id connect(Slot&& s)
         {
-            auto s = slot_ptr_type(new slot_type(std::forward<Func>(f), static_cast<detail::signal_base*>(this)));
-            connection c(s);
-            add_slot(std::move(s));
-            return c;
+            return emplace(std::move(s));
         }
 
-        // Connect a slot with a pointer to member function.
-        // or pointer to member data.
-        template<typename Func, typename Ptr, 
-            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Ptr, Args...>::value>,
-            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
-        connection connect(Func&& f, Ptr&& p)
+        // Disconnect a slot.
+        // Returns false if the slot was already disconnected.
+        bool disconnect(slot_id id)
         {
-            auto s = slot_ptr_type(new slot_type(std::forward<Func>(f), std::forward<Ptr>(p), static_cast<detail::signal_base*>(this)));
-            connection c(s);
-            add_slot(std::move(s));
-            return c;
+            lock_type lock(m_Mutex);
+
+            if (!valid(id))
+            {
+                return false;
+            }
+
+            if (m_Invocations > 0)
+            {
+                // The identifier is freed without allocating when the invocation returns.
+                reserve(m_FreeIds, m_FreeIds.size() + m_PendingDisconnects.size() + 1);
+            }
+
+            auto& entry = m_Entries[id.index];
+            if (entry.position == pending)
+            {
+                const auto iter = std::find_if(m_PendingConnects.begin(), m_PendingConnects.end(), [&id](const std::unique_ptr<pending_slot>& p)
+                {
+                    return p->index == id.index;
+                });
+                m_PendingConnects.erase(iter);
+                free_id(id.index);
+            }
+            else if (m_Invocations > 0)
+            {
+                // Invalidate the identifier now and remove the slot later.
+                m_PendingDisconnects.push_back(id.index);
+                ++entry.generation;
+            }
+            else
+            {
+                remove_slot(entry.position);
+                free_id(id.index);
+                trim_chunks();
+            }
+
+            --m_NumSlots;
+            return true;
         }
 
-        // Connect a previously created slot.
-        // Returns a scoped_connection.
-        scoped_connection connect_scoped(const slot_type& slot)
+        // Returns true if the slot is connected.
+        bool connected(slot_id id) const
         {
-            return scoped_connection(connect(slot));
+            lock_type lock(m_Mutex);
+            return valid(id);
         }
 
-        // Connect a slot with a callable function object.
-        // Returns a scoped connection.
-        template<typename Func, 
-            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, detail::traits::remove_cvref_t<Func>, Args...>::value>,
-            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
-        scoped_connection connect_scoped(Func&& f)
+        // Disconnect all slots.
+        void clear()
         {
-            return scoped_connection(connect<Func>(std::forward<Func>(f)));
+            lock_type lock(m_Mutex);
+
+            for (const auto& p : m_PendingConnects)
+            {
+                free_id(p->index);
+            }
+            m_PendingConnects.clear();
+
+            if (m_Invocations > 0)
+            {
+                reserve(m_PendingDisconnects, m_PendingDisconnects.size() + m_Size);
+                reserve(m_FreeIds, m_FreeIds.size() + m_PendingDisconnects.size() + m_Size);
+                for (std::size_t i = 0; i < m_Size; ++i)
+                {
+                    auto& entry = m_Entries[m_Ids[i]];
+                    if (entry.generation % 2 != 0)
+                    {
+                        ++entry.generation;
+                        m_PendingDisconnects.push_back(m_Ids[i]);
+                    }
+                }
+            }
+            else
+            {
+                for (const auto index : m_Ids)
+                {
+                    free_id(index);
+                }
+                destroy_slots();
+                m_Ids.clear();
+            }
+
+            m_NumSlots = 0;
         }
 
-        // Connect a slot with a pointer to member function
-        // or pointer to member data.
-        // Returns a scoped connection.
-        template<typename Func, typename Ptr, 
-            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, Func, Ptr, Args...>::value>,
-            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
-        scoped_connection connect_scoped(Func&& f, Ptr&& p)
+        std::size_t num_slots() const
         {
-            return scoped_connection(connect<Func>(std::forward<Func>(f), std::forward<Ptr>(p)));
+            lock_type lock(m_Mutex);
+            return m_NumSlots;
         }
 
-        // Disconnect a slot.
-        std::size_t disconnect(const slot_type& slot)
+        bool empty() const
         {
-            return erase(slot);
+            return num_slots() == 0;
         }
 
-        // Disconnect any slots that are bound to the function object.
-        // Returns the number of slots that were disconnected.
-        template<typename Func,
-            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, Func, Args...>::value>,
-            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
-        std::size_t disconnect(Func&& f)
+        // Invoke all slots.
+        // The slot mutex is only locked before and after the slots are invoked.
+        void operator()(Args... args)
         {
-            // Create a temporary slot for comparison.
-            auto s = slot<R(Args...)>(std::forward<Func>(f));
-            return erase(s);
+            std::size_t count;
+            {
+                lock_type lock(m_Mutex);
+                ++m_Invocations;
+                count = m_Size;
+            }
+            const invocation_guard guard(*this);
+
+            // The chunks are not modified while the signal is being invoked.
+            for (std::size_t c = 0; count > 0; ++c)
+            {
+                const auto n = count < ChunkSize ? count : ChunkSize;
+                invoke_slots(m_Chunks[c]->slots(), n, args...);
+                count -= n;
+            }
         }
 
-        // Disconnect any slots that are bound to the function object.
-        // Returns the number of slots that were disconnected.
-        template<typename Func, typename Ptr,
-            typename = detail::traits::enable_if_t<detail::traits::is_invocable_r<R, Func, Ptr, Args...>::value>,
-            typename = detail::traits::enable_if_t<!std::is_base_of<detail::slot_base, detail::traits::remove_cvref_t<Func>>::value>>
-        std::size_t disconnect(Func&& f, Ptr&& p)
+    private:
+        enum : std::size_t
         {
-            // Create a temporary slot for comparison.
-            auto s = slot<R(Args...)>(std::forward<Func>(f), std::forward<Ptr>(p));
-            return erase(s);
-        }
+            npos = static_cast<std::size_t>(-1),        // A free identifier.
+            pending = static_cast<std::size_t>(-2),     // A slot that is connected when the invocations return.
+        };
+
+        // The number of slots ahead of the invoked slot that is prefetched.
+        static constexpr std::size_t prefetch_distance = SIG_PREFETCH_DISTANCE / sizeof(Slot);
+        static constexpr std::size_t slots_per_line = sizeof(Slot) < 64 ? 64 / sizeof(Slot) : 1;
+
+        using storage_type = typename std::aligned_storage<sizeof(Slot), alignof(Slot)>::type;
+
+        struct chunk
+        {
+            Slot* slots() noexcept
+            {
+                return reinterpret_cast<Slot*>(storage);
+            }
+
+            storage_type storage[ChunkSize];
+        };
 
-        result_type operator()(Args... args) const
+        // The position of the slot of an identifier.
+        // The generation is odd while a slot is connected.
+        struct id_entry
         {
-            if (m_Blocked) return {};
+            std::size_t position;
+            std::size_t generation;
+        };
 
-            auto t = std::tuple<Args...>(std::forward<Args>(args)...);
+        struct pending_slot
+        {
+            std::size_t index;
+            Slot slot;
+        };
 
-            // Get a read-only copy of the slots.
-            const auto slots_copy = read_slots();
-            const auto& slots = slots_copy.read();
+        // Applies the pending changes when the last invocation returns.
+        // This doesn't allocate, so it can't throw from the destructor.
+        struct invocation_guard
+        {
+            explicit invocation_guard(fanout_signal& s) noexcept
+                : signal(s)
+            {}
+
+            ~invocation_guard()
+            {
+                signal.finish_invocation();
+            }
+
+            fanout_signal& signal;
+        };
 
-            using iterator = detail::slot_iterator<R, list_iterator, Args...>;
-            return Combiner()(iterator(slots.begin(), t), iterator(slots.end(), t));
+        // Prefetch once per cache line (of 64 bytes) of slots.
+        static void invoke_slots(Slot* slots, std::size_t count, Args&... args)
+        {
+            std::size_t i = 0;
+            if (prefetch_distance > 0)
+            {
+                for (; i + prefetch_distance + slots_per_line <= count; i += slots_per_line)
+                {
+                    detail::prefetch(slots + i + prefetch_distance);
+                    for (std::size_t j = 0; j < slots_per_line; ++j)
+                    {
+                        detail::invoke_slot<void>(slots[i + j], args...);
+                    }
+                }
+            }
+            for (; i < count; ++i)
+            {
+                detail::invoke_slot<void>(slots[i], args...);
+            }
         }
 
-    private:
-        template <typename>
-        friend class slot;
-        
-        void add_slot(slot_ptr_type&& s)
+        Slot& slot_at(std::size_t position) noexcept
         {
-            lock_type lock(m_SlotMutex);
-            auto& slots = m_Slots.write();
+            return m_Chunks[position / ChunkSize]->slots()[position % ChunkSize];
+        }
 
-            s->state().index() = slots.size();
-            slots.push_back(std::move(s));
+        bool valid(slot_id id) const noexcept
+        {
+            return id.index < m_Entries.size() && m_Entries[id.index].generation == id.generation && id.generation % 2 != 0;
         }
 
-        // Remove a slot at the given index.
-        virtual void remove_slot(detail::slot_base& slot) override
+        std::size_t allocate_id()
         {
-            lock_type lock(m_SlotMutex);
-            auto i = slot.index();
-            auto& slots = m_Slots.write();
+            std::size_t index;
+            if (m_FreeIds.empty())
+            {
+                index = m_Entries.size();
+                m_Entries.push_back(id_entry{ npos, 1 });
+            }
+            else
+            {
+                index = m_FreeIds.back();
+                m_FreeIds.pop_back();
+                ++m_Entries[index].generation;
+            }
+            return index;
+        }
 
-            if (!slots.empty() && i < slots.size())
+        void free_id(std::size_t index)
+        {
+            auto& entry = m_Entries[index];
+            entry.position = npos;
+            if (entry.generation % 2 != 0)
             {
-                std::swap(slots[i], slots.back());
-                slots[i]->index() = i;
-                slots.pop_back();
+                ++entry.generation;
             }
+            m_FreeIds.push_back(index);
         }
 
-        // Erase all slots that match given slot.
-        // @param slot The slot to match for erasure.
-        // @returns The number of slots that were actually erased.
-        template<typename Func>
-        size_t erase(const slot<Func>& slot)
+        // Grow the capacity of the vector to at least n elements.
+        template<typename T>
+        static void reserve(std::vector<T>& v, std::size_t n)
         {
-            lock_type lock(m_SlotMutex);
-            auto& slots = m_Slots.write();
+            if (v.capacity() < n)
+            {
+                v.reserve(std::max(n, v.capacity() * 2));
+            }
+        }
 
-            std::size_t count = 0;   // The number of slots that were removed.
-            std::size_t i = 0;       // Slot index
-            while (i < slots.size())
+        // Allocate the chunks and the identifier positions of count slots.
+        // During an invocation, the invocation reads the chunk list without
+        // locking the mutex, so the chunks are allocated in a separate list,
+        // along with a chunk list that can hold all of the chunks. They are
+        // moved into the chunk list without allocating when the last
+        // invocation returns (see splice_chunks).
+        void reserve_slots(std::size_t count)
+        {
+            const auto chunks = (count + ChunkSize - 1) / ChunkSize;
+            if (m_Invocations > 0)
             {
-                auto& s = *slots[i];
-                if (s == slot)
+                while (m_Chunks.size() + m_PendingChunks.size() < chunks)
                 {
-                    std::swap(slots[i], slots.back());
-                    slots[i]->index() = i;
-                    slots.pop_back();
-                    ++count;
+                    m_PendingChunks.push_back(std::unique_ptr<chunk>(new chunk));
                 }
-                else
+                if (m_Chunks.capacity() < chunks)
                 {
-                    ++i;
+                    reserve(m_PendingChunkList, chunks);
                 }
             }
-            return count;
+            else
+            {
+                while (m_Chunks.size() < chunks)
+                {
+                    m_Chunks.push_back(std::unique_ptr<chunk>(new chunk));
+                }
+            }
+            reserve(m_Ids, count);
         }
 
-        void clear()
+        // Move the chunks that were allocated during the invocations into
+        // the chunk list. Replaces the chunk list with the reserved one if
+        // the chunks don't fit.
+        void splice_chunks() noexcept
         {
-            lock_type lock(m_SlotMutex);
-            m_Slots->clear();
+            const auto chunks = m_Chunks.size() + m_PendingChunks.size();
+            if (m_Chunks.capacity() < chunks)
+            {
+                for (auto& c : m_Chunks)
+                {
+                    m_PendingChunkList.push_back(std::move(c));
+                }
+                m_Chunks.swap(m_PendingChunkList);
+                m_PendingChunkList.clear();
+            }
+
+            for (auto& c : m_PendingChunks)
+            {
+                m_Chunks.push_back(std::move(c));
+            }
+            m_PendingChunks.clear();
         }
 
-        // Get a copy of the slots for reading.
-        const cow_type read_slots() const
+        template<typename... SlotArgs>
+        void push_slot(SlotArgs&&... args)
         {
-            lock_type lock(m_SlotMutex);
-            return m_Slots;
+            reserve_slots(m_Size + 1);
+            ::new(&slot_at(m_Size)) Slot(std::forward<SlotArgs>(args)...);
+            ++m_Size;
         }
 
-        mutable mutex_type m_SlotMutex;
-        cow_type m_Slots;
-        std::atomic_bool m_Blocked;
+        // Move the last slot into the position of the removed slot.
+        // The chunks that are no longer used are kept until trim_chunks.
+        void remove_slot(std::size_t position) noexcept
+        {
+            const auto last = m_Size - 1;
+            auto& slot = slot_at(position);
+            slot.~Slot();
+            if (position != last)
+            {
+                auto& back = slot_at(last);
+                ::new(&slot) Slot(std::move(back));
+                back.~Slot();
+                m_Ids[position] = m_Ids[last];
+                m_Entries[m_Ids[position]].position = position;
+            }
+            m_Ids.pop_back();
+            m_Size = last;
+        }
+
+        // Free the chunks after the chunk of the last slot.
+        void trim_chunks() noexcept
+        {
+            while (!m_Chunks.empty() && (m_Chunks.size() - 1) * ChunkSize >= m_Size)
+            {
+                m_Chunks.pop_back();
+            }
+        }
+
+        void destroy_slots() noexcept
+        {
+            while (m_Size > 0)
+            {
+                slot_at(--m_Size).~Slot();
+            }
+            m_Chunks.clear();
+        }
+
+        void finish_invocation()
+        {
+            lock_type lock(m_Mutex);
+            if (--m_Invocations > 0)
+            {
+                return;
+            }
+
+            for (const auto index : m_PendingDisconnects)
+            {
+                remove_slot(m_Entries[index].position);
+                free_id(index);
+            }
+            m_PendingDisconnects.clear();
+
+            // The chunks and identifiers were reserved when the slots were connected.
+            splice_chunks();
+            for (const auto& p : m_PendingConnects)
+            {
+                push_slot(std::move(p->slot));
+                m_Entries[p->index].position = m_Size - 1;
+                m_Ids.push_back(p->index);
+            }
+            m_PendingConnects.clear();
+            trim_chunks();
+        }
+
+        mutable mutex_type m_Mutex;
+        std::vector<std::unique_ptr<chunk>> m_Chunks;                 // All chunks are full except for the last used chunk.
+        std::vector<std::size_t> m_Ids;                               // The identifier of the slot at each position.
+        std::vector<id_entry> m_Entries;                              // The slot position of each identifier.
+        std::vector<std::size_t> m_FreeIds;                           // Identifiers that can be reused.
+        std::vector<std::unique_ptr<pending_slot>> m_PendingConnects; // Slots that are connected during an invocation.
+        std::vector<std::size_t> m_PendingDisconnects;                // Slots that are disconnected during an invocation.
+        std::vector<std::unique_ptr<chunk>> m_PendingChunks;          // Chunks that are allocated during an invocation.
+        std::vector<std::unique_ptr<chunk>> m_PendingChunkList;       // Room for all chunks if m_Chunks is too small.
+        std::size_t m_Size;                                           // The number of slots in the chunks.
+        std::size_t m_NumSlots;                                       // The number of connected slots.
+        std::size_t m_Invocations;                                    // The number of invocations in progress.
     };
 } // namespace sig
\ No newline at end of file
@@ -0,0 +1,313 @@
+/**
+ * A concurrency stress test for the signals library.
+ *
+ * Every thread performs a random sequence of operations on a few shared signals
+ * for the given duration: connecting and disconnecting slots, blocking slots,
+ * invoking the signals, destroying scoped connections, and destroying objects
+ * that are tracked by slots. At the end, the number of operations per second
+ * is reported and the invariants of the signals are checked.
+ *
+ * Build with -DSIG_SANITIZER=thread or -DSIG_SANITIZER=address (or use the
+ * tsan and asan CMake presets) to find data races and memory errors.
+ *
+ * Command line options:
+ *   --threads=<count>      The number of threads (default: the number of hardware threads).
+ *   --duration=<seconds>   How long to run (default 10).
+ *   --signals=<count>      The number of shared signals (default 4).
+ *   --slots=<count>        The maximum number of connections that a thread keeps (default 16).
+ *   --seed=<seed>          The seed of the random number generators (default 1).
+ */
+
+#include <signals.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using signal = sig::signal<int(int)>;
+    using clock_type = std::chrono::steady_clock;
+
+    enum operation
+    {
+        op_connect,
+        op_disconnect,
+        op_block,
+        op_unblock,
+        op_emit,
+        op_connect_scoped,
+        op_destroy_scoped,
+        op_connect_tracked,
+        op_destroy_tracked,
+        num_operations
+    };
+
+    const char* const operation_names[num_operations] = {
+        "connect",
+        "disconnect",
+        "block",
+        "unblock",
+        "emit",
+        "connect_scoped",
+        "destroy_scoped",
+        "connect_tracked",
+        "destroy_tracked",
+    };
+
+    struct options
+    {
+        unsigned threads;
+        double duration;
+        unsigned signals;
+        unsigned slots;
+        unsigned seed;
+    };
+
+    // Invocations of all slots.
+    std::atomic<std::uint64_t> g_Invocations(0);
+    // Invocations of tracked slots whose object was already destroyed.
+    std::atomic<std::uint64_t> g_Errors(0);
+
+    // An object that is tracked by the slots that are connected to it.
+    class tracked
+    {
+    public:
+        tracked()
+            : m_Alive(alive)
+        {}
+
+        ~tracked()
+        {
+            m_Alive = 0;
+        }
+
+        int on_signal(int i)
+        {
+            if (m_Alive != alive)
+            {
+                ++g_Errors;
+            }
+            g_Invocations.fetch_add(1, std::memory_order_relaxed);
+            return i;
+        }
+
+    private:
+        static const unsigned alive = 0xA11CEu;
+        std::atomic<unsigned> m_Alive;
+    };
+
+    int on_signal(int i)
+    {
+        g_Invocations.fetch_add(1, std::memory_order_relaxed);
+        return i;
+    }
+
+    struct thread_result
+    {
+        std::array<std::uint64_t, num_operations> counts;
+    };
+
+    // Remove a random element of a vector (the order is not preserved).
+    template<typename T>
+    T take_random(std::vector<T>& v, std::mt19937& random)
+    {
+        const auto i = std::uniform_int_distribution<std::size_t>(0, v.size() - 1)(random);
+        std::swap(v[i], v.back());
+        T result = std::move(v.back());
+        v.pop_back();
+        return result;
+    }
+
+    void run(std::vector<signal>& signals, const options& opts, unsigned index, const std::atomic_bool& stop, thread_result& result)
+    {
+        std::mt19937 random(opts.seed + index);
+        std::uniform_int_distribution<int> next_operation(0, num_operations - 1);
+        std::uniform_int_distribution<std::size_t> next_signal(0, signals.size() - 1);
+
+        std::vector<sig::connection> connections;
+        std::vector<sig::connection_blocker> blockers;
+        std::vector<sig::scoped_connection> scoped;
+        std::vector<std::shared_ptr<tracked>> objects;
+
+        result.counts.fill(0);
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            auto& s = signals[next_signal(random)];
+            auto op = static_cast<operation>(next_operation(random));
+
+            // Keep the number of connections bounded.
+            if (op == op_connect && connections.size() >= opts.slots) op = op_disconnect;
+            if (op == op_connect_scoped && scoped.size() >= opts.slots) op = op_destroy_scoped;
+            if (op == op_connect_tracked && objects.size() >= opts.slots) op = op_destroy_tracked;
+            if (op == op_block && blockers.size() >= opts.slots) op = op_unblock;
+
+            switch (op)
+            {
+            case op_connect:
+                connections.push_back(s.connect(&on_signal));
+                break;
+            case op_disconnect:
+                if (connections.empty()) continue;
+                take_random(connections, random).disconnect();
+                break;
+            case op_block:
+                if (connections.empty()) continue;
+                blockers.push_back(connections[std::uniform_int_distribution<std::size_t>(0, connections.size() - 1)(random)].blocker());
+                break;
+            case op_unblock:
+                if (blockers.empty()) continue;
+                take_random(blockers, random);
+                break;
+            case op_emit:
+                s(1);
+                break;
+            case op_connect_scoped:
+                scoped.push_back(s.connect_scoped([](int i) { return on_signal(i); }));
+                break;
+            case op_destroy_scoped:
+                if (scoped.empty()) continue;
+                take_random(scoped, random);
+                break;
+            case op_connect_tracked:
+                objects.push_back(std::make_shared<tracked>());
+                s.connect(&tracked::on_signal, objects.back());
+                break;
+            case op_destroy_tracked:
+                if (objects.empty()) continue;
+                take_random(objects, random);
+                break;
+            default:
+                continue;
+            }
+
+            ++result.counts[op];
+        }
+
+        for (auto& c : connections)
+        {
+            c.disconnect();
+        }
+    }
+
+    bool parse(int argc, char* argv[], options& opts)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const auto eq = arg.find('=');
+            const auto name = arg.substr(0, eq);
+            const auto value = eq == std::string::npos ? std::string() : arg.substr(eq + 1);
+
+            if (name == "--threads")
+                opts.threads = static_cast<unsigned>(std::atoi(value.c_str()));
+            else if (name == "--duration")
+                opts.duration = std::atof(value.c_str());
+            else if (name == "--signals")
+                opts.signals = static_cast<unsigned>(std::atoi(value.c_str()));
+            else if (name == "--slots")
+                opts.slots = static_cast<unsigned>(std::atoi(value.c_str()));
+            else if (name == "--seed")
+                opts.seed = static_cast<unsigned>(std::atoi(value.c_str()));
+            else
+            {
+                std::cerr << "Unknown option " << arg << std::endl;
+                return false;
+            }
+        }
+
+        if (opts.threads == 0 || opts.signals == 0 || opts.slots == 0 || opts.duration <= 0.0)
+        {
+            std::cerr << "--threads, --signals, --slots, and --duration must be positive" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    options opts{ std::thread::hardware_concurrency(), 10.0, 4, 16, 1 };
+    if (opts.threads == 0) opts.threads = 4;
+
+    if (!parse(argc, argv, opts))
+    {
+        return 2;
+    }
+
+    std::cout << "Running " << opts.threads << " threads on " << opts.signals << " signals for "
+        << opts.duration << " s (seed " << opts.seed << ")" << std::endl;
+
+    std::vector<signal> signals(opts.signals);
+    std::vector<thread_result> results(opts.threads);
+    std::vector<std::thread> threads;
+    std::atomic_bool stop(false);
+
+    const auto start = clock_type::now();
+    for (unsigned i = 0; i < opts.threads; ++i)
+    {
+        threads.emplace_back(run, std::ref(signals), std::cref(opts), i, std::cref(stop), std::ref(results[i]));
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(opts.duration));
+    stop = true;
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    const auto seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    // Report the throughput.
+    std::uint64_t total = 0;
+    std::cout << std::fixed << std::setprecision(0);
+    for (int op = 0; op < num_operations; ++op)
+    {
+        std::uint64_t count = 0;
+        for (const auto& r : results)
+        {
+            count += r.counts[op];
+        }
+        total += count;
+
+        std::cout << std::setw(16) << std::left << operation_names[op] << std::right
+            << std::setw(12) << count << std::setw(14) << count / seconds << " ops/s" << std::endl;
+    }
+    std::cout << std::setw(16) << std::left << "total" << std::right
+        << std::setw(12) << total << std::setw(14) << total / seconds << " ops/s" << std::endl;
+    std::cout << std::setw(16) << std::left << "invocations" << std::right
+        << std::setw(12) << g_Invocations.load() << std::setw(14) << g_Invocations.load() / seconds << " slots/s" << std::endl;
+
+    // All slots were disconnected when the threads returned, except for the
+    // tracked slots, which are skipped the next time the signal is invoked.
+    bool ok = true;
+    for (auto& s : signals)
+    {
+        s(0);
+
+        if (s.num_slots() != 0)
+        {
+            std::cerr << "Error: " << s.num_slots() << " slots are still connected" << std::endl;
+            ok = false;
+        }
+    }
+
+    if (g_Errors != 0)
+    {
+        std::cerr << "Error: " << g_Errors << " slots were invoked after their tracked object was destroyed" << std::endl;
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
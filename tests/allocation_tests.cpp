@@ -0,0 +1,327 @@
+/**
+ * Tests that invoking a signal does not allocate memory, and that connecting
+ * a slot allocates the slot and its function object together.
+ * This file replaces the global allocation functions with functions that count
+ * the allocations, so it is compiled into a separate test executable.
+ */
+
+#include <signals.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace
+{
+    std::atomic<std::size_t> g_Allocations(0);
+
+    void* allocate(std::size_t size)
+    {
+        ++g_Allocations;
+        if (auto p = std::malloc(size ? size : 1))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    // Count the allocations that are made while invoking f.
+    template<typename Func>
+    std::size_t count_allocations(Func&& f)
+    {
+        const auto before = g_Allocations.load();
+        f();
+        return g_Allocations.load() - before;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    ++g_Allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    ++g_Allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    int add(int i, int j)
+    {
+        return i + j;
+    }
+
+    void increment(int& counter)
+    {
+        ++counter;
+    }
+
+    void twice(int& counter)
+    {
+        counter += 2;
+    }
+
+    struct IsNegative
+    {
+        bool operator()(int i) const
+        {
+            return i < 0;
+        }
+    };
+
+    struct Adder
+    {
+        int add(int i, int j) const
+        {
+            return i + j + offset;
+        }
+
+        int offset = 1;
+    };
+}
+
+TEST(allocation, CountingAllocator)
+{
+    // Sanity check that allocations are counted.
+    EXPECT_EQ(count_allocations([] { delete new int(3); }), 1u);
+}
+
+TEST(allocation, SlotKinds)
+{
+    sig::signal<int(int, int)> s;
+
+    // slot_func
+    s.connect(&add);
+    s.connect([](int i, int j) { return i * j; });
+
+    // slot_pmf
+    Adder adder;
+    s.connect(&Adder::add, &adder);
+
+    // slot_pmf_tracked
+    auto tracked = std::make_shared<Adder>();
+    s.connect(&Adder::add, tracked);
+
+    // slot_func_extended
+    s.connect_extended([](sig::connection_handle&, int i, int j) { return i - j; });
+
+    opt::optional<int> result;
+    EXPECT_EQ(count_allocations([&] { result = s(3, 5); }), 0u);
+    EXPECT_EQ(result, -2);
+
+    // An expired tracked slot does not allocate either.
+    tracked.reset();
+    EXPECT_EQ(count_allocations([&] { result = s(3, 5); }), 0u);
+}
+
+TEST(allocation, HeapSlotList)
+{
+    // More slots than fit inline.
+    sig::signal<void(int&)> s;
+    for (int i = 0; i < SIG_INLINE_SLOTS * 4; ++i)
+    {
+        s.connect([](int& counter) { ++counter; });
+    }
+
+    int counter = 0;
+    EXPECT_EQ(count_allocations([&] { s(counter); }), 0u);
+    EXPECT_EQ(counter, SIG_INLINE_SLOTS * 4);
+}
+
+TEST(allocation, BlockedAndFiltered)
+{
+    sig::signal<int(int)> s;
+    auto c = s.connect([](int i) { return i; });
+    s.connect(sig::filter([](int i) { return i > 0; }), [](int i) { return i * 2; });
+
+    opt::optional<int> result;
+    EXPECT_EQ(count_allocations([&] { result = s(-1); }), 0u);
+    EXPECT_EQ(result, -1);
+
+    sig::connection_blocker blocker = c.blocker();
+    EXPECT_EQ(count_allocations([&] { result = s(3); }), 0u);
+    EXPECT_EQ(result, 6);
+}
+
+TEST(allocation, ShortCircuitCombiners)
+{
+    sig::signal<int(int), sig::first_engaged<int>> first;
+    first.connect([](int i) { return i; });
+
+    sig::signal<bool(int), sig::any_of> any;
+    any.connect([](int i) { return i > 0; });
+
+    sig::signal<bool(int), sig::all_of> all;
+    all.connect([](int i) { return i > 0; });
+
+    sig::signal<int(int), sig::first_that<int, IsNegative>> negative;
+    negative.connect([](int i) { return i; });
+    negative.connect([](int i) { return -i; });
+
+    EXPECT_EQ(count_allocations([&] { first(1); any(1); all(1); negative(1); }), 0u);
+}
+
+TEST(allocation, ReductionCombiners)
+{
+    // The reduction combiners collect the results on the stack, so they
+    // don't allocate memory, even on the first invocation.
+    sig::signal<int(int), sig::sum_value<int>> s;
+    for (int i = 0; i < 100; ++i)
+    {
+        s.connect([](int i) { return i; });
+    }
+
+    opt::optional<int> result;
+    EXPECT_EQ(count_allocations([&] { result = s(2); }), 0u);
+    EXPECT_EQ(result, 200);
+
+    sig::signal<double(double), sig::mean_value<double>> mean;
+    mean.connect([](double d) { return d; });
+    mean.connect([](double d) { return d * 3; });
+
+    opt::optional<double> average;
+    EXPECT_EQ(count_allocations([&] { average = mean(2.0); }), 0u);
+    EXPECT_EQ(average, 4.0);
+
+    sig::signal<int(int), sig::min_value<int>> min;
+    sig::signal<int(int), sig::max_value<int>> max;
+    for (int i = 1; i <= 2; ++i)
+    {
+        min.connect([i](int j) { return i * j; });
+        max.connect([i](int j) { return i * j; });
+    }
+
+    opt::optional<int> low, high;
+    EXPECT_EQ(count_allocations([&] { low = min(3); high = max(3); }), 0u);
+    EXPECT_EQ(low, 3);
+    EXPECT_EQ(high, 6);
+}
+
+TEST(allocation, SlotStorage)
+{
+    sig::signal<void(int&), sig::optional_last_value<void>, sig::inline_slots<16>> large;
+    sig::signal<void(int&), sig::optional_last_value<void>, sig::chunked_slots<4>> chunked;
+    sig::nothrow_signal<void(int&)> nothrow;
+    sig::signal<void(int&), sig::optional_last_value<void>, sig::type_grouped_slots<>> grouped;
+    for (int i = 0; i < 8; ++i)
+    {
+        large.connect([](int& counter) { ++counter; });
+        chunked.connect([](int& counter) { ++counter; });
+        nothrow.connect([](int& counter) noexcept { ++counter; });
+        grouped.connect(i % 2 ? &increment : &twice);
+    }
+
+    int counter = 0;
+    EXPECT_EQ(count_allocations([&] { large(counter); chunked(counter); nothrow(counter); grouped(counter); }), 0u);
+    EXPECT_EQ(counter, 8 * 3 + 12);
+}
+
+TEST(allocation, Forwarding)
+{
+    // The slot lists of up to SIG_INLINE_FORWARDS targets are stored inside
+    // the invocation.
+    sig::signal<int(int), sig::sum_value<int>> source;
+    std::vector<sig::signal<int(int), sig::sum_value<int>>> targets(SIG_INLINE_FORWARDS);
+    source.connect([](int i) { return i; });
+    for (auto& target : targets)
+    {
+        target.connect([](int i) { return i; });
+        source.forward_to(target);
+    }
+
+    opt::optional<int> result;
+    EXPECT_EQ(count_allocations([&] { result = source(2); }), 0u);
+    EXPECT_EQ(result, 2 * (SIG_INLINE_FORWARDS + 1));
+}
+
+TEST(allocation, EmitDuringDisconnect)
+{
+    // Disconnecting a slot during the invocation does not make the invocation allocate.
+    sig::signal<void()> s;
+    sig::connection c;
+    c = s.connect([&c] { c.disconnect(); });
+    s.connect([] {});
+
+    EXPECT_EQ(count_allocations([&] { s(); }), 0u);
+    EXPECT_EQ(s.num_slots(), 1u);
+}
+
+TEST(allocation, ConnectMoveOnly)
+{
+    sig::signal<int(int, int)> s;
+    std::unique_ptr<int> offset(new int(1));
+
+    // The slot and the function object are stored in a single allocation
+    // (the slots themselves are stored inside the signal).
+    auto lambda = [offset = std::move(offset)](int i, int j) { return i + j + *offset; };
+    EXPECT_EQ(count_allocations([&] { s.connect(std::move(lambda)); }), 1u);
+    EXPECT_EQ(count_allocations([&] { s.connect(&add); }), 1u);
+    EXPECT_EQ(count_allocations([&] { s.connect(sig::filter([](int i, int) { return i > 0; }), &add); }), 1u);
+
+    EXPECT_EQ(s(1, 2), 3);
+}
+
+TEST(allocation, FanoutDeferredChanges)
+{
+    // The slots that are connected or disconnected during an invocation are
+    // added or removed without allocating when the invocation returns.
+    sig::fanout_signal<void(), std::function<void()>, 2> s;
+    const auto first = s.connect([] {});
+    s.connect([] {});
+
+    std::size_t allocations = 0;
+    bool modified = false;
+    s.connect([&]
+    {
+        if (!modified)
+        {
+            modified = true;
+            for (int i = 0; i < 4; ++i)
+            {
+                s.connect([] {});
+            }
+            s.disconnect(first);
+        }
+        allocations = g_Allocations.load();
+    });
+
+    s();
+    EXPECT_EQ(g_Allocations.load(), allocations);
+    EXPECT_EQ(s.num_slots(), 6u);
+}
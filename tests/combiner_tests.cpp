@@ -0,0 +1,171 @@
+/**
+ * Tests the reduction combiners and the kernels they use.
+ */
+
+#include <signals.hpp>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST(combiner, AlignedBuffer)
+{
+    sig::detail::aligned_buffer<float> buffer;
+    EXPECT_TRUE(buffer.empty());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        buffer.push_back(static_cast<float>(i));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer.data()) % 32, 0u);
+    }
+
+    EXPECT_EQ(buffer.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(buffer.data()[i], static_cast<float>(i));
+    }
+
+    // Copies start out empty.
+    auto copy = buffer;
+    EXPECT_TRUE(copy.empty());
+
+    auto moved = std::move(buffer);
+    EXPECT_EQ(moved.size(), 100u);
+    EXPECT_TRUE(buffer.empty());
+}
+
+// Compare the kernels against the portable kernels for all sizes
+// around the width of the SIMD registers.
+template<typename T>
+void TestKernels()
+{
+    for (std::size_t count = 1; count < 40; ++count)
+    {
+        sig::detail::aligned_buffer<T> buffer;
+        std::vector<T> values;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // Values that can be summed exactly in any order.
+            T value = static_cast<T>((i * 7) % 13) - static_cast<T>(6);
+            buffer.push_back(value);
+            values.push_back(value);
+        }
+
+        EXPECT_EQ(sig::detail::simd::sum(buffer.data(), count), sig::detail::simd::sum<T>(values.data(), count));
+        EXPECT_EQ(sig::detail::simd::minimum(buffer.data(), count), sig::detail::simd::minimum<T>(values.data(), count));
+        EXPECT_EQ(sig::detail::simd::maximum(buffer.data(), count), sig::detail::simd::maximum<T>(values.data(), count));
+    }
+}
+
+TEST(combiner, Kernels)
+{
+    TestKernels<float>();
+    TestKernels<double>();
+    TestKernels<int>();
+}
+
+TEST(combiner, Reduce)
+{
+    sig::signal<float(float), sig::sum_value<float>> sum;
+    sig::signal<float(float), sig::min_value<float>> min;
+    sig::signal<float(float), sig::max_value<float>> max;
+    sig::signal<float(float), sig::mean_value<float>> mean;
+
+    EXPECT_FALSE(sum(1.0f));
+    EXPECT_FALSE(min(1.0f));
+    EXPECT_FALSE(max(1.0f));
+    EXPECT_FALSE(mean(1.0f));
+
+    std::vector<sig::connection> connections;
+    for (int i = 1; i <= 10; ++i)
+    {
+        auto f = [i](float x) { return x * static_cast<float>(i); };
+        connections.push_back(sum.connect(f));
+        min.connect(f);
+        max.connect(f);
+        mean.connect(f);
+    }
+
+    EXPECT_EQ(sum(2.0f), 110.0f);
+    EXPECT_EQ(min(2.0f), 2.0f);
+    EXPECT_EQ(max(2.0f), 20.0f);
+    EXPECT_EQ(mean(2.0f), 11.0f);
+
+    // Blocked slots are not included.
+    connections.back().block();
+    EXPECT_EQ(sum(2.0f), 90.0f);
+}
+
+TEST(combiner, ReduceIntegral)
+{
+    sig::signal<int(), sig::mean_value<int>> s;
+
+    s.connect([]() { return 1; });
+    s.connect([]() { return 2; });
+
+    // Integral means are rounded towards zero.
+    EXPECT_EQ(s(), 1);
+}
+
+TEST(combiner, ReduceBlocks)
+{
+    sig::signal<int(int), sig::sum_value<int>> sum;
+    sig::signal<int(int), sig::min_value<int>> min;
+    sig::signal<int(int), sig::max_value<int>> max;
+    sig::signal<int(int), sig::mean_value<int>> mean;
+
+    // The results are reduced in blocks, so connect enough slots to fill
+    // several blocks and a partial one.
+    for (int i = 1; i <= 200; ++i)
+    {
+        auto f = [i](int x) { return x * (i == 150 ? -i : i); };
+        sum.connect(f);
+        min.connect(f);
+        max.connect(f);
+        mean.connect(f);
+    }
+
+    EXPECT_EQ(sum(1), 200 * 201 / 2 - 300);
+    EXPECT_EQ(min(1), -150);
+    EXPECT_EQ(max(1), 200);
+    EXPECT_EQ(mean(1), (200 * 201 / 2 - 300) / 200);
+}
+
+void reduce_many(sig::signal<int(int), sig::sum_value<int>>& sum, sig::signal<int(int), sig::mean_value<int>>& mean, int x, std::atomic_int& errors)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (sum(x) != 100 * x) ++errors;
+        if (mean(x) != x) ++errors;
+    }
+}
+
+// Test that the reduction combiners can be used by multiple threads at the same time.
+TEST(combiner, ReduceThreaded)
+{
+    sig::signal<int(int), sig::sum_value<int>> sum;
+    sig::signal<int(int), sig::mean_value<int>> mean;
+    for (int i = 0; i < 100; ++i)
+    {
+        sum.connect([](int x) { return x; });
+        mean.connect([](int x) { return x; });
+    }
+
+    std::atomic_int errors{0};
+
+    std::array<std::thread, 4> threads;
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i] = std::thread(reduce_many, std::ref(sum), std::ref(mean), static_cast<int>(i + 1), std::ref(errors));
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(errors, 0);
+}
@@ -0,0 +1,304 @@
+/**
+ * Tests the fanout_signal class.
+ */
+
+#include <signals.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Appends its value to the list when invoked.
+    struct push
+    {
+        void operator()(std::vector<int>& v) const
+        {
+            v.push_back(value);
+        }
+
+        int value;
+    };
+
+    using fanout = sig::fanout_signal<void(std::vector<int>&), push, 4>;
+
+    std::vector<int> sorted(std::vector<int> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+}
+
+TEST(fanout_signal, Invoke)
+{
+    fanout s;
+    EXPECT_TRUE(s.empty());
+
+    // Enough slots to fill more than one chunk.
+    for (int i = 0; i < 10; ++i)
+    {
+        s.connect(push{ i });
+    }
+    EXPECT_EQ(s.num_slots(), 10u);
+
+    std::vector<int> v;
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+}
+
+TEST(fanout_signal, Disconnect)
+{
+    fanout s;
+
+    std::vector<fanout::slot_id> ids;
+    for (int i = 0; i < 10; ++i)
+    {
+        ids.push_back(s.emplace(push{ i }));
+    }
+
+    // The last slot is moved into the place of a disconnected slot.
+    EXPECT_TRUE(s.disconnect(ids[2]));
+    EXPECT_FALSE(s.disconnect(ids[2]));
+    EXPECT_FALSE(s.connected(ids[2]));
+    EXPECT_TRUE(s.connected(ids[9]));
+
+    std::vector<int> v;
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 0, 1, 9, 3, 4, 5, 6, 7, 8 }));
+
+    // Disconnecting the moved slot uses its new position.
+    EXPECT_TRUE(s.disconnect(ids[9]));
+    EXPECT_TRUE(s.disconnect(ids[0]));
+
+    v.clear();
+    s(v);
+    EXPECT_EQ(sorted(v), std::vector<int>({ 1, 3, 4, 5, 6, 7, 8 }));
+
+    // The identifiers of disconnected slots stay invalid when a slot is connected.
+    const auto id = s.connect(push{ 10 });
+    EXPECT_NE(id, ids[0]);
+    EXPECT_NE(id, ids[9]);
+    EXPECT_FALSE(s.connected(ids[0]));
+    EXPECT_FALSE(s.disconnect(ids[9]));
+    EXPECT_EQ(s.num_slots(), 8u);
+
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_FALSE(s.connected(id));
+
+    v.clear();
+    s(v);
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(fanout_signal, ModifyDuringInvocation)
+{
+    using callback = std::function<void(int&)>;
+    sig::fanout_signal<void(int&), callback, 2> s;
+
+    void (*increment)(int&) = [](int& i) { ++i; };
+    const auto first = s.connect(increment);
+    s.connect(increment);
+
+    sig::fanout_signal<void(int&), callback, 2>::slot_id connected{};
+    bool modify = true;
+    s.connect([&](int&)
+    {
+        if (modify)
+        {
+            modify = false;
+
+            // The changes are applied when the invocation returns.
+            connected = s.connect(increment);
+            EXPECT_TRUE(s.disconnect(first));
+            EXPECT_FALSE(s.connected(first));
+            EXPECT_TRUE(s.connected(connected));
+            EXPECT_EQ(s.num_slots(), 3u);
+
+            // A slot that was connected during the invocation can be disconnected.
+            const auto temp = s.connect(increment);
+            EXPECT_TRUE(s.disconnect(temp));
+        }
+    });
+
+    int counter = 0;
+    s(counter);
+    EXPECT_EQ(counter, 2);
+
+    counter = 0;
+    s(counter);
+    EXPECT_EQ(counter, 2);
+    EXPECT_EQ(s.num_slots(), 3u);
+
+    // Disconnect all slots during an invocation.
+    s.connect([&](int&) { s.clear(); });
+    counter = 0;
+    s(counter);
+    EXPECT_TRUE(s.empty());
+
+    counter = 0;
+    s(counter);
+    EXPECT_EQ(counter, 0);
+}
+
+TEST(fanout_signal, MoveOnlySlots)
+{
+    struct counter
+    {
+        void operator()(int i)
+        {
+            *total += i;
+        }
+
+        std::unique_ptr<int> total;
+    };
+
+    sig::fanout_signal<void(int), counter> s;
+    int* totals[3];
+    for (auto& total : totals)
+    {
+        std::unique_ptr<int> p(new int(0));
+        total = p.get();
+        s.emplace(counter{ std::move(p) });
+    }
+
+    s(2);
+    for (auto total : totals)
+    {
+        EXPECT_EQ(*total, 2);
+    }
+
+    // Lambdas can't be assigned, but they can be moved.
+    auto make_slot = [](int* p) { return [p](int i) { *p += i; }; };
+    sig::fanout_signal<void(int), decltype(make_slot(nullptr))> l;
+
+    int values[3] = {};
+    const auto id = l.connect(make_slot(&values[0]));
+    l.connect(make_slot(&values[1]));
+    l.connect(make_slot(&values[2]));
+    l.disconnect(id);
+
+    l(3);
+    EXPECT_EQ(values[0], 0);
+    EXPECT_EQ(values[1], 3);
+    EXPECT_EQ(values[2], 3);
+}
+
+TEST(fanout_signal, Threads)
+{
+    sig::fanout_signal<void(), std::function<void()>, 16> s;
+
+    std::atomic<int> count(0);
+    for (int i = 0; i < 100; ++i)
+    {
+        s.connect([&count] { ++count; });
+    }
+
+    // Connect and disconnect slots while other threads invoke the signal.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&s]
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                s();
+            }
+        });
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto id = s.connect([] {});
+        EXPECT_TRUE(s.disconnect(id));
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(s.num_slots(), 100u);
+    EXPECT_EQ(count, 400 * 100);
+}
+
+TEST(fanout_signal, ConnectDuringEmit)
+{
+    // A chunk of one slot makes every connect during an invocation
+    // allocate a chunk.
+    sig::fanout_signal<void(), std::function<void()>, 1> s;
+
+    std::atomic<int> count(0);
+    s.connect([&count] { ++count; });
+
+    // Emit while another thread connects slots, so that the connects
+    // happen while the signal is being invoked.
+    std::atomic<bool> done(false);
+    std::thread emitter([&]
+    {
+        while (!done)
+        {
+            s();
+        }
+    });
+
+    std::vector<sig::fanout_signal<void(), std::function<void()>, 1>::slot_id> ids;
+    for (int i = 0; i < 2000; ++i)
+    {
+        ids.push_back(s.connect([] {}));
+        if (i % 2 != 0)
+        {
+            EXPECT_TRUE(s.disconnect(ids[i / 2]));
+        }
+    }
+
+    done = true;
+    emitter.join();
+
+    s();
+    EXPECT_EQ(s.num_slots(), 1001u);
+    EXPECT_GT(count, 0);
+}
+
+TEST(fanout_signal, ThrowingSlotConstructor)
+{
+    // Constructing the slot throws if the value is negative.
+    struct slot
+    {
+        explicit slot(int v)
+            : value(v)
+        {
+            if (v < 0)
+            {
+                throw std::invalid_argument("negative value");
+            }
+        }
+
+        void operator()(std::vector<int>& v) const
+        {
+            v.push_back(value);
+        }
+
+        int value;
+    };
+
+    sig::fanout_signal<void(std::vector<int>&), slot, 2> s;
+    s.emplace(1);
+    EXPECT_THROW(s.emplace(-1), std::invalid_argument);
+    const auto id = s.emplace(2);
+    EXPECT_EQ(s.num_slots(), 2u);
+
+    // The identifier of the failed slot was released and the slots are consistent.
+    EXPECT_TRUE(s.disconnect(id));
+    s.emplace(3);
+
+    std::vector<int> v;
+    s(v);
+    EXPECT_EQ(sorted(v), std::vector<int>({ 1, 3 }));
+}
@@ -0,0 +1,122 @@
+/**
+ * Tests the keyed_signal class.
+ */
+
+#include <signals.hpp>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST(keyed_signal, Dispatch)
+{
+    using signal = sig::keyed_signal<int, void(std::vector<std::string>&)>;
+    signal s;
+
+    s.connect(1, [](std::vector<std::string>& v) { v.push_back("1a"); });
+    s.connect(1, [](std::vector<std::string>& v) { v.push_back("1b"); });
+    s.connect(2, [](std::vector<std::string>& v) { v.push_back("2"); });
+    auto any = s.connect_any([](std::vector<std::string>& v) { v.push_back("*"); });
+
+    EXPECT_EQ(s.num_slots(), 4u);
+    EXPECT_EQ(s.num_slots(1), 2u);
+    EXPECT_EQ(s.num_keys(), 2u);
+
+    std::vector<std::string> v;
+    s(1, v);
+    EXPECT_EQ(v, std::vector<std::string>({ "1a", "1b", "*" }));
+
+    v.clear();
+    s(2, v);
+    EXPECT_EQ(v, std::vector<std::string>({ "2", "*" }));
+
+    // Keys without slots only invoke the wildcard slots.
+    v.clear();
+    s(3, v);
+    EXPECT_EQ(v, std::vector<std::string>({ "*" }));
+
+    any.disconnect();
+    v.clear();
+    s(3, v);
+    EXPECT_TRUE(v.empty());
+
+    EXPECT_EQ(s.disconnect(1), 2u);
+    EXPECT_EQ(s.num_slots(), 1u);
+    v.clear();
+    s(1, v);
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(keyed_signal, Disconnect)
+{
+    using signal = sig::keyed_signal<std::string, int(int)>;
+    signal s;
+
+    std::vector<sig::connection> connections;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto key = std::to_string(i % 100);
+        connections.push_back(s.connect(key, [i](int x) { return x + i; }));
+    }
+
+    EXPECT_EQ(s.num_keys(), 100u);
+    EXPECT_EQ(s.num_slots(), 1000u);
+
+    // The default combiner returns the result of the last slot of the key.
+    EXPECT_EQ(s("42", 1), 943);
+    EXPECT_FALSE(s("unknown", 1));
+
+    // Disconnect the last slot of the key.
+    connections[942].disconnect();
+    EXPECT_EQ(s("42", 1), 843);
+    EXPECT_EQ(s.num_slots("42"), 9u);
+    EXPECT_EQ(s.num_slots(), 999u);
+}
+
+TEST(keyed_signal, DisconnectDuringInvoke)
+{
+    using signal = sig::keyed_signal<int, int(), sig::sum_value<int>>;
+    signal s;
+
+    sig::connection c;
+    c = s.connect(1, [&c]() { c.disconnect(); return 1; });
+    s.connect(1, []() { return 2; });
+    s.connect_any([]() { return 10; });
+
+    // The slots of the key are copied before they are invoked.
+    EXPECT_EQ(s(1), 13);
+    EXPECT_EQ(s(1), 12);
+}
+
+TEST(keyed_signal, TrackedSlotExpired)
+{
+    struct counter
+    {
+        int value() const { return 1; }
+    };
+
+    using signal = sig::keyed_signal<int, int(), sig::sum_value<int>>;
+    signal s;
+
+    auto tracked = std::make_shared<counter>();
+    auto any = std::make_shared<counter>();
+    s.connect(1, &counter::value, tracked);
+    s.connect_any(&counter::value, any);
+    s.connect(1, []() { return 10; });
+    EXPECT_EQ(s(1), 12);
+
+    // The expired slots are skipped and no longer counted.
+    tracked.reset();
+    any.reset();
+    EXPECT_EQ(s(1), 10);
+    EXPECT_EQ(s.num_slots(), 1u);
+    EXPECT_EQ(s.num_slots(1), 1u);
+
+    // They are removed the next time a slot is connected.
+    s.connect(2, []() { return 20; });
+    EXPECT_EQ(s.num_slots(), 2u);
+    EXPECT_EQ(s.num_slots(1), 1u);
+    EXPECT_EQ(s(1), 10);
+    EXPECT_EQ(s(2), 20);
+}
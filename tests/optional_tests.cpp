@@ -0,0 +1,70 @@
+/**
+ * Tests the opt::optional type used to return slot results.
+ */
+
+#include <optional.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <type_traits>
+
+// A trivially copyable type without a default constructor.
+struct Point
+{
+    Point(int _x, int _y)
+        : x(_x)
+        , y(_y)
+    {}
+
+    int x, y;
+};
+
+// Optionals of trivially copyable types must be trivially copyable so that
+// they can be returned in registers.
+static_assert(std::is_trivially_copyable<opt::optional<int>>::value, "optional<int> must be trivially copyable.");
+static_assert(std::is_trivially_copyable<opt::optional<double>>::value, "optional<double> must be trivially copyable.");
+static_assert(std::is_trivially_copyable<opt::optional<Point>>::value, "optional<Point> must be trivially copyable.");
+static_assert(std::is_trivially_copyable<opt::optional<int&>>::value, "optional<int&> must be trivially copyable.");
+static_assert(std::is_trivially_copyable<opt::optional<void>>::value, "optional<void> must be trivially copyable.");
+static_assert(std::is_trivially_destructible<opt::optional<float>>::value, "optional<float> must be trivially destructible.");
+static_assert(!std::is_trivially_copyable<opt::optional<std::string>>::value, "optional<std::string> cannot be trivially copyable.");
+
+TEST(optional, Scalar)
+{
+    opt::optional<int> o1;
+    EXPECT_FALSE(o1);
+
+    o1 = 3;
+    EXPECT_TRUE(o1);
+    EXPECT_EQ(*o1, 3);
+
+    opt::optional<int> o2 = o1;
+    EXPECT_EQ(o1, o2);
+
+    o1.reset();
+    EXPECT_FALSE(o1);
+    EXPECT_EQ(*o2, 3);
+
+    o2 = opt::nullopt;
+    EXPECT_FALSE(o2);
+}
+
+TEST(optional, TriviallyCopyable)
+{
+    opt::optional<Point> o1;
+    EXPECT_FALSE(o1);
+
+    o1.emplace(1, 2);
+    EXPECT_TRUE(o1);
+    EXPECT_EQ(o1->x, 1);
+    EXPECT_EQ(o1->y, 2);
+
+    opt::optional<Point> o2(Point(3, 4));
+    o1 = o2;
+    EXPECT_EQ(o1->x, 3);
+    EXPECT_EQ(o1->y, 4);
+
+    o2 = opt::nullopt;
+    o1 = o2;
+    EXPECT_FALSE(o1);
+}
@@ -0,0 +1,243 @@
+/**
+ * Tests the lock and copy-on-write counters that are recorded when SIG_SIGNAL_STATS is enabled.
+ * This file is compiled into a separate test executable with SIG_SIGNAL_STATS=1.
+ */
+
+#include <signals.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if !SIG_SIGNAL_STATS
+#error "signal_stats_tests must be compiled with SIG_SIGNAL_STATS=1"
+#endif
+
+namespace
+{
+    bool registered(const void* id)
+    {
+        const auto all = sig::collect_signal_stats();
+        return std::any_of(all.begin(), all.end(), [id](const sig::signal_stats& s) { return s.id == id; });
+    }
+}
+
+TEST(signal_stats, Empty)
+{
+    sig::signal<void()> s;
+
+    const auto stats = s.stats();
+    EXPECT_EQ(stats.id, &s);
+    EXPECT_EQ(stats.name, nullptr);
+    EXPECT_EQ(stats.lock_acquisitions, 0u);
+    EXPECT_EQ(stats.contended_acquisitions, 0u);
+    EXPECT_EQ(stats.wait_ns, 0u);
+    EXPECT_EQ(stats.cow_copies, 0u);
+    EXPECT_EQ(stats.bytes_copied, 0u);
+    EXPECT_EQ(stats.peak_slots, 0u);
+}
+
+TEST(signal_stats, LockAcquisitions)
+{
+    sig::signal<void()> s;
+
+    auto c = s.connect([] {});
+    const auto connected = s.stats().lock_acquisitions;
+    EXPECT_GT(connected, 0u);
+
+    // Every invocation locks the slot mutex to read the slot list.
+    s();
+    s();
+    EXPECT_GT(s.stats().lock_acquisitions, connected);
+
+    // Without other threads there is no contention.
+    EXPECT_EQ(s.stats().contended_acquisitions, 0u);
+    EXPECT_EQ(s.stats().wait_ns, 0u);
+}
+
+TEST(signal_stats, PeakSlots)
+{
+    sig::signal<void()> s;
+
+    std::vector<sig::connection> connections;
+    for (int i = 0; i < 10; ++i)
+    {
+        connections.push_back(s.connect([] {}));
+    }
+    for (auto& c : connections)
+    {
+        c.disconnect();
+    }
+
+    EXPECT_EQ(s.num_slots(), 0u);
+    EXPECT_EQ(s.stats().peak_slots, 10u);
+}
+
+TEST(signal_stats, CopyOnWrite)
+{
+    using signal = sig::signal<void()>;
+    signal s;
+
+    // Enough slots to store the slot list on the heap.
+    const std::size_t size = SIG_INLINE_SLOTS + 1;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        s.connect([] {});
+    }
+    EXPECT_EQ(s.stats().cow_copies, 0u);
+
+    // Connecting a slot while the signal is being invoked copies the slot list
+    // because the invocation holds a reference to it.
+    bool connected = false;
+    s.connect([&]
+    {
+        if (!connected)
+        {
+            connected = true;
+            s.connect([] {});
+        }
+    });
+    EXPECT_EQ(s.stats().cow_copies, 0u);
+
+    s();
+
+    const auto stats = s.stats();
+    EXPECT_EQ(stats.cow_copies, 1u);
+    EXPECT_EQ(stats.bytes_copied, (size + 1) * sizeof(signal::slot_ptr_type));
+    EXPECT_EQ(stats.peak_slots, size + 2);
+
+    // Without a concurrent invocation, no copy is made.
+    s.connect([] {});
+    EXPECT_EQ(s.stats().cow_copies, 1u);
+}
+
+TEST(signal_stats, ChunkedCopyOnWrite)
+{
+    using signal = sig::signal<void(), sig::optional_last_value<void>, sig::chunked_slots<16>>;
+    signal s;
+
+    const std::size_t size = 1024;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        s.connect([] {});
+    }
+    EXPECT_EQ(s.stats().cow_copies, 0u);
+
+    // Connecting a slot while the signal is being invoked only copies the
+    // chunk pointers and the last chunk, instead of the whole slot list.
+    bool connected = false;
+    s.connect([&]
+    {
+        if (!connected)
+        {
+            connected = true;
+            s.connect([] {});
+        }
+    });
+
+    s();
+
+    const auto stats = s.stats();
+    EXPECT_EQ(stats.cow_copies, 2u);
+    EXPECT_LT(stats.bytes_copied, size * sizeof(signal::slot_ptr_type) / 4);
+    EXPECT_EQ(stats.peak_slots, size + 2);
+}
+
+TEST(signal_stats, ChunkedEraseCopyOnWrite)
+{
+    using signal = sig::signal<void(), sig::optional_last_value<void>, sig::chunked_slots<16>>;
+    signal s;
+
+    void (*f)() = [] {};
+    const std::size_t size = 1024;
+    s.connect(f);
+    for (std::size_t i = 1; i < size; ++i)
+    {
+        s.connect([] {});
+    }
+
+    // Disconnecting equivalent slots while the signal is being invoked only
+    // copies the chunk pointers and the chunk of the removed slot, instead of
+    // the slots that follow it.
+    bool disconnected = false;
+    s.connect([&]
+    {
+        if (!disconnected)
+        {
+            disconnected = true;
+            s.disconnect(f);
+        }
+    });
+
+    s();
+
+    const auto stats = s.stats();
+    EXPECT_EQ(stats.cow_copies, 2u);
+    EXPECT_LT(stats.bytes_copied, size * sizeof(signal::slot_ptr_type) / 4);
+    EXPECT_EQ(s.num_slots(), size);
+}
+
+TEST(signal_stats, Contention)
+{
+    sig::signal<void(int)> s;
+
+    auto churn = [&s]
+    {
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto c = s.connect([](int) {});
+            s(i);
+            c.disconnect();
+        }
+    };
+
+    std::thread t1(churn);
+    std::thread t2(churn);
+    t1.join();
+    t2.join();
+
+    const auto stats = s.stats();
+    EXPECT_GE(stats.lock_acquisitions, 2u * 2000u * 3u);
+    EXPECT_LE(stats.contended_acquisitions, stats.lock_acquisitions);
+    if (stats.contended_acquisitions == 0)
+    {
+        EXPECT_EQ(stats.wait_ns, 0u);
+    }
+}
+
+TEST(signal_stats, Registry)
+{
+    std::unique_ptr<sig::signal<void()>> s(new sig::signal<void()>());
+    s->set_name("registered");
+    s->connect([] {});
+
+    const auto all = sig::collect_signal_stats();
+    auto iter = std::find_if(all.begin(), all.end(), [&s](const sig::signal_stats& stats) { return stats.id == s.get(); });
+    ASSERT_NE(iter, all.end());
+    EXPECT_STREQ(iter->name, "registered");
+    EXPECT_EQ(iter->peak_slots, 1u);
+
+    // Destroyed signals are removed from the registry.
+    const void* id = s.get();
+    s.reset();
+    EXPECT_FALSE(registered(id));
+}
+
+TEST(signal_stats, Move)
+{
+    sig::signal<void()> s1;
+    s1.set_name("moved");
+    s1.connect([] {});
+    s1.connect([] {});
+
+    sig::signal<void()> s2(std::move(s1));
+
+    const auto stats = s2.stats();
+    EXPECT_EQ(stats.id, &s2);
+    EXPECT_STREQ(stats.name, "moved");
+    EXPECT_EQ(stats.peak_slots, 2u);
+    EXPECT_TRUE(registered(&s1));
+    EXPECT_TRUE(registered(&s2));
+}
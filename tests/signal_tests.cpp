@@ -6,6 +6,7 @@
 #include <functional>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 using namespace std::placeholders;
 
@@ -220,6 +221,41 @@ TEST(signal, PointerToMemberFunctionTracked)
     // released.
     EXPECT_EQ(vmf.use_count(), 0);
 
+    // The expired slot is no longer counted by the signal.
+    EXPECT_EQ(s.num_slots(), 0u);
+}
+
+TEST(signal, TrackedSlotRemoved)
+{
+    using signal = sig::signal<void()>;
+    signal s;
+
+    std::vector<std::shared_ptr<VoidMemberFunc>> objects;
+    for (int i = 0; i < 10; ++i)
+    {
+        objects.push_back(std::make_shared<VoidMemberFunc>());
+        s.connect(&VoidMemberFunc::DoSomething, objects.back());
+    }
+    EXPECT_EQ(s.num_slots(), 10u);
+
+    // Destroying a tracked object disconnects its slot the next time
+    // the signal is invoked, and the slot is removed the next time a slot
+    // is connected or disconnected, so the slot list doesn't keep growing.
+    objects.erase(objects.begin() + 2, objects.end());
+    s();
+    EXPECT_EQ(s.num_slots(), 2u);
+
+    auto other = std::make_shared<VoidMemberFunc>();
+    auto c = s.connect(&VoidMemberFunc::DoSomething, other);
+    EXPECT_EQ(s.num_slots(), 3u);
+
+    objects.clear();
+    s();
+    EXPECT_EQ(s.num_slots(), 1u);
+
+    c.disconnect();
+    EXPECT_EQ(s.num_slots(), 0u);
+    EXPECT_TRUE(s.empty());
 }
 
 // Add to the atomic value.
@@ -514,4 +550,914 @@ TEST(signal, ConnectSlot)
 
     // Invoke the signal again.
     s();
-}
\ No newline at end of file
+}
+
+TEST(signal, InlineSlots)
+{
+    // Store at most 2 slots inside the signal.
+    using signal = sig::signal<void(int&), sig::optional_last_value<void>, sig::inline_slots<2>>;
+
+    signal s;
+
+    auto c1 = s.connect(&increment_counter);
+    auto c2 = s.connect(&increment_counter);
+
+    int counter = 0;
+    s(counter);
+    EXPECT_EQ(counter, 2);
+
+    // Spill the slots to the heap.
+    auto c3 = s.connect(&increment_counter);
+    auto c4 = s.connect(&increment_counter);
+
+    s(counter);
+    EXPECT_EQ(counter, 6);
+
+    // Disconnecting slots moves the slots back into the signal.
+    c1.disconnect();
+    c4.disconnect();
+    c3.disconnect();
+
+    s(counter);
+    EXPECT_EQ(counter, 7);
+
+    EXPECT_EQ(s.disconnect(&increment_counter), 1);
+
+    s(counter);
+    EXPECT_EQ(counter, 7);
+}
+
+TEST(signal, Groups)
+{
+    using signal = sig::signal<void(std::vector<int>&)>;
+
+    signal s;
+
+    // Append the value to the list when invoked.
+    auto push = [](int value)
+    {
+        return [value](std::vector<int>& v) { v.push_back(value); };
+    };
+
+    s.connect(push(6));                         // Ungrouped, at back.
+    s.connect(2, push(4));
+    s.connect(1, push(2));
+    s.connect(2, push(5));
+    s.connect(1, push(1), sig::at_front);
+    s.connect(push(0), sig::at_front);          // Ungrouped, at front.
+    auto c3 = s.connect(1, push(3));
+
+    std::vector<int> v;
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 0, 1, 2, 3, 4, 5, 6 }));
+
+    // Disconnecting a slot preserves the order of the remaining slots.
+    c3.disconnect();
+    v.clear();
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 0, 1, 2, 4, 5, 6 }));
+
+    // Disconnect all of the slots in a group.
+    EXPECT_EQ(s.disconnect(2), 2);
+    EXPECT_EQ(s.disconnect(2), 0);
+    v.clear();
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 0, 1, 2, 6 }));
+
+    // Reconnecting a group places the slots in the correct order again.
+    s.connect(2, push(5));
+    s.connect(0, push(-1));
+    v.clear();
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 0, -1, 1, 2, 5, 6 }));
+    EXPECT_EQ(s.num_slots(), 6);
+}
+
+TEST(signal, DisconnectReassignedKeys)
+{
+    using signal = sig::signal<void(std::vector<int>&)>;
+    signal s;
+
+    auto push = [](int value)
+    {
+        return [value](std::vector<int>& v) { v.push_back(value); };
+    };
+
+    // Every slot of the group is inserted before the ungrouped slot, which
+    // eventually reassigns the keys that the connections use to find their slots.
+    s.connect(push(1000));
+    std::vector<sig::connection> connections;
+    for (int i = 0; i < 200; ++i)
+    {
+        connections.push_back(s.connect(1, push(i)));
+    }
+
+    std::vector<int> expected;
+    for (int i = 0; i < 200; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            EXPECT_TRUE(connections[i].disconnect());
+        }
+        else
+        {
+            expected.push_back(i);
+        }
+    }
+    expected.push_back(1000);
+
+    std::vector<int> v;
+    s(v);
+    EXPECT_EQ(v, expected);
+
+    for (auto& c : connections)
+    {
+        c.disconnect();
+    }
+    EXPECT_EQ(s.num_slots(), 1u);
+}
+
+TEST(signal, DisconnectEquivalent)
+{
+    using signal = sig::signal<void(int&)>;
+
+    signal s;
+
+    auto c1 = s.connect(&increment_counter);
+    auto c2 = s.connect([](int& i) { i += 10; });
+
+    // Disconnecting by value also disconnects the connection.
+    EXPECT_EQ(s.disconnect(&increment_counter), 1);
+    EXPECT_FALSE(c1.connected());
+    EXPECT_FALSE(c1.disconnect());
+
+    // The remaining slot is still connected.
+    int counter = 0;
+    s(counter);
+    EXPECT_EQ(counter, 10);
+    EXPECT_TRUE(c2.connected());
+}
+
+TEST(signal, ExtendedConnection)
+{
+    using signal = sig::signal<void(int&)>;
+
+    signal s;
+
+    // A slot that disconnects itself after it is invoked.
+    auto c1 = s.connect_extended([](sig::connection_handle& c, int& i)
+    {
+        ++i;
+        c.disconnect();
+    });
+
+    // A slot that disconnects itself after it is invoked 3 times.
+    int calls = 0;
+    auto c2 = s.connect_extended([&calls](sig::connection_handle& c, int& i)
+    {
+        EXPECT_TRUE(c.connected());
+        i += 10;
+        if (++calls == 3)
+        {
+            c.disconnect();
+        }
+    });
+
+    int counter = 0;
+    s(counter);
+    EXPECT_EQ(counter, 11);
+    EXPECT_FALSE(c1.connected());
+    EXPECT_TRUE(c2.connected());
+
+    s(counter);
+    s(counter);
+    s(counter);
+    EXPECT_EQ(counter, 31);
+    EXPECT_FALSE(c2.connected());
+    EXPECT_TRUE(s.empty());
+}
+
+TEST(signal, ExtendedConnectionBlock)
+{
+    using signal = sig::signal<int(int)>;
+
+    signal s;
+
+    // A slot that blocks itself after it is invoked.
+    auto c = s.connect_extended([](sig::connection_handle& h, int i)
+    {
+        h.block();
+        return i * 2;
+    });
+
+    EXPECT_EQ(s(3), 6);
+    EXPECT_TRUE(c.blocked());
+    EXPECT_FALSE(s(3));
+
+    c.unblock();
+    EXPECT_EQ(s(4), 8);
+}
+
+struct IsNegative
+{
+    bool operator()(int i) const
+    {
+        return i < 0;
+    }
+};
+
+TEST(signal, ShortCircuitCombiners)
+{
+    int calls = 0;
+    auto validator = [&calls](bool result)
+    {
+        return [&calls, result](int) { ++calls; return result; };
+    };
+
+    {
+        using signal = sig::signal<bool(int), sig::all_of>;
+        signal s;
+
+        // No slots connected.
+        EXPECT_TRUE(s(0));
+
+        s.connect(validator(true));
+        auto c = s.connect(validator(false));
+        s.connect(validator(true));
+
+        // The last slot is not invoked after the first rejection.
+        EXPECT_FALSE(s(0));
+        EXPECT_EQ(calls, 2);
+
+        // Blocked slots are ignored.
+        c.block();
+        calls = 0;
+        EXPECT_TRUE(s(0));
+        EXPECT_EQ(calls, 2);
+    }
+
+    {
+        using signal = sig::signal<bool(int), sig::any_of>;
+        signal s;
+
+        EXPECT_FALSE(s(0));
+
+        s.connect(validator(false));
+        s.connect(validator(true));
+        s.connect(validator(false));
+
+        calls = 0;
+        EXPECT_TRUE(s(0));
+        EXPECT_EQ(calls, 2);
+    }
+
+    {
+        using signal = sig::signal<int(int), sig::first_engaged<int>>;
+        signal s;
+
+        EXPECT_FALSE(s(0));
+
+        auto c = s.connect([&calls](int i) { ++calls; return i; });
+        s.connect([&calls](int i) { ++calls; return i * 2; });
+
+        calls = 0;
+        EXPECT_EQ(s(3), 3);
+        EXPECT_EQ(calls, 1);
+
+        // The first engaged result is from the second slot.
+        c.block();
+        EXPECT_EQ(s(3), 6);
+    }
+
+    {
+        using signal = sig::signal<int(int), sig::first_that<int, IsNegative>>;
+        signal s;
+
+        s.connect([&calls](int i) { ++calls; return i; });
+        s.connect([&calls](int i) { ++calls; return -i; });
+        s.connect([&calls](int i) { ++calls; return -i * 2; });
+
+        calls = 0;
+        EXPECT_EQ(s(3), -3);
+        EXPECT_EQ(calls, 2);
+    }
+}
+
+// A combiner that reuses its result vector and counts the number of invocations.
+class collect_values
+{
+public:
+    using result_type = const std::vector<int>&;
+
+    template<typename InputIterator>
+    result_type operator()(InputIterator first, InputIterator last)
+    {
+        ++invocations;
+        values.clear();
+        for (; first != last; ++first)
+        {
+            auto value = *first;
+            if (value)
+                values.push_back(*value);
+        }
+        return values;
+    }
+
+    std::vector<int> values;
+    int invocations = 0;
+};
+
+TEST(signal, CombinerInstance)
+{
+    using signal = sig::signal<int(int), collect_values>;
+
+    collect_values combiner;
+    combiner.values.reserve(16);
+    signal s(std::move(combiner));
+
+    s.connect([](int i) { return i; });
+    s.connect([](int i) { return i * 2; });
+
+    const auto* data = s.combiner().values.data();
+
+    EXPECT_EQ(s(2), std::vector<int>({ 2, 4 }));
+    EXPECT_EQ(s(3), std::vector<int>({ 3, 6 }));
+    EXPECT_EQ(s.combiner().invocations, 2);
+
+    // The result vector is reused.
+    EXPECT_EQ(s.combiner().values.data(), data);
+
+    s.set_combiner(collect_values());
+    EXPECT_EQ(s.combiner().invocations, 0);
+
+    // The combiner is moved with the signal.
+    s(1);
+    signal s2(std::move(s));
+    EXPECT_EQ(s2.combiner().invocations, 1);
+}
+
+TEST(signal, PerThreadCombiner)
+{
+    using signal = sig::signal<int(int), sig::per_thread<collect_values>>;
+    signal s;
+
+    s.connect([](int i) { return i; });
+    s.connect([](int i) { return i + 1; });
+
+    const int iterations = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&s, t, iterations]()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                const auto& values = s(t);
+                EXPECT_EQ(values, std::vector<int>({ t, t + 1 }));
+            }
+            EXPECT_EQ(s.combiner().local().invocations, iterations);
+        });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    // The main thread has its own combiner.
+    EXPECT_EQ(s.combiner().local().invocations, 0);
+}
+
+TEST(signal, PerThreadCombinerNewThread)
+{
+    using signal = sig::signal<int(int), sig::per_thread<collect_values>>;
+    signal s;
+
+    s.connect([](int i) { return i; });
+
+    // A thread that is started after another thread exited starts from the
+    // prototype, even if it reuses the id of the thread that exited.
+    for (int t = 0; t < 4; ++t)
+    {
+        std::thread thread([&s, t]()
+        {
+            EXPECT_EQ(s.combiner().local().invocations, 0);
+            EXPECT_EQ(s(t), std::vector<int>({ t }));
+            EXPECT_EQ(s.combiner().local().invocations, 1);
+        });
+        thread.join();
+    }
+}
+
+TEST(signal, EmitBatch)
+{
+    using signal = sig::signal<int(int, const std::string&)>;
+    signal s;
+
+    // Record the order in which the slots are invoked.
+    std::vector<std::string> order;
+    auto c = s.connect([&order](int i, const std::string& str)
+    {
+        order.push_back("a" + str);
+        return i;
+    });
+    s.connect([&order](int i, const std::string& str)
+    {
+        order.push_back("b" + str);
+        return i * 2;
+    });
+
+    // The argument sets refer to the strings, so they must outlive the batch.
+    const std::string one("1"), two("2"), three("3");
+    std::vector<signal::args_type> batch = {
+        signal::args_type(1, one),
+        signal::args_type(2, two),
+        signal::args_type(3, three),
+    };
+
+    auto results = s.emit_batch(batch);
+
+    // The default combiner returns the result of the last slot for each argument set.
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0], 2);
+    EXPECT_EQ(results[1], 4);
+    EXPECT_EQ(results[2], 6);
+
+    // Slots are invoked in slot-major order.
+    EXPECT_EQ(order, std::vector<std::string>({ "a1", "a2", "a3", "b1", "b2", "b3" }));
+
+    // Blocked slots are not invoked.
+    c.block();
+    order.clear();
+    results = s.emit_batch(batch);
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0], 2);
+    EXPECT_EQ(order, std::vector<std::string>({ "b1", "b2", "b3" }));
+
+    // An empty batch does not invoke any slots.
+    order.clear();
+    EXPECT_TRUE(s.emit_batch(std::vector<signal::args_type>()).empty());
+    EXPECT_TRUE(order.empty());
+}
+
+TEST(signal, EmitBatchArguments)
+{
+    // Arguments passed by value are copied for every slot.
+    sig::signal<std::size_t(std::string), sig::sum_value<std::size_t>> s1;
+    s1.connect([](std::string str) { return str.size(); });
+    s1.connect([](std::string str) { return str.size(); });
+
+    std::vector<std::tuple<std::string>> batch1 = { std::make_tuple(std::string("abc")), std::make_tuple(std::string("de")) };
+    auto results = s1.emit_batch(batch1.begin(), batch1.end());
+    EXPECT_EQ(results[0], std::size_t(6));
+    EXPECT_EQ(results[1], std::size_t(4));
+
+    // Arguments passed by reference refer to the same object.
+    sig::signal<void(int&)> s2;
+    s2.connect([](int& i) { ++i; });
+    s2.connect([](int& i) { i *= 10; });
+
+    int a = 1, b = 2;
+    std::vector<std::tuple<int&>> batch2 = { std::tie(a), std::tie(b) };
+    s2.emit_batch(batch2.begin(), batch2.end());
+    EXPECT_EQ(a, 20);
+    EXPECT_EQ(b, 30);
+}
+
+TEST(signal, ForwardTo)
+{
+    using signal = sig::signal<void(std::vector<int>&)>;
+
+    signal a, b, c;
+    a.connect([](std::vector<int>& v) { v.push_back(1); });
+    b.connect([](std::vector<int>& v) { v.push_back(2); });
+    c.connect([](std::vector<int>& v) { v.push_back(3); });
+
+    a.forward_to(b);
+    b.forward_to(c);
+
+    // Forwarding to the same signal twice has no effect.
+    a.forward_to(b);
+
+    std::vector<int> v;
+    a(v);
+    EXPECT_EQ(v, std::vector<int>({ 1, 2, 3 }));
+
+    v.clear();
+    b(v);
+    EXPECT_EQ(v, std::vector<int>({ 2, 3 }));
+
+    // Forwarding cycles are detected when forwarding is set up.
+    EXPECT_THROW(c.forward_to(a), sig::forwarding_cycle_exception);
+    EXPECT_THROW(a.forward_to(a), sig::forwarding_cycle_exception);
+
+    EXPECT_TRUE(a.stop_forwarding(b));
+    EXPECT_FALSE(a.stop_forwarding(b));
+
+    v.clear();
+    a(v);
+    EXPECT_EQ(v, std::vector<int>({ 1 }));
+
+    // Now c may forward to a.
+    c.forward_to(a);
+    v.clear();
+    b(v);
+    EXPECT_EQ(v, std::vector<int>({ 2, 3, 1 }));
+}
+
+TEST(signal, ForwardToDestroyed)
+{
+    using signal = sig::signal<int(int), sig::sum_value<int>>;
+
+    signal a;
+    a.connect([](int i) { return i; });
+
+    {
+        signal b;
+        b.connect([](int i) { return i * 10; });
+        a.forward_to(b);
+
+        // The results of the forwarded slots are combined by the source signal.
+        EXPECT_EQ(a(2), 22);
+
+        std::vector<signal::args_type> batch = { std::make_tuple(1), std::make_tuple(3) };
+        auto results = a.emit_batch(batch);
+        EXPECT_EQ(results[0], 11);
+        EXPECT_EQ(results[1], 33);
+
+        // The source signal c is destroyed before its target.
+        std::unique_ptr<signal> c(new signal());
+        c->forward_to(a);
+        EXPECT_EQ((*c)(1), 11);
+    }
+
+    // Destroying the target signal b stops forwarding to it.
+    EXPECT_EQ(a(2), 2);
+}
+
+TEST(signal, ForwardToDestroyedDuringInvocation)
+{
+    using signal = sig::signal<int(int), sig::sum_value<int>>;
+
+    signal a;
+    std::unique_ptr<signal> b(new signal());
+    std::unique_ptr<signal> c(new signal());
+    a.forward_to(*b);
+    b->forward_to(*c);
+
+    // Destroying a target while its slots are being invoked skips
+    // the remaining slots of the target.
+    int calls = 0;
+    a.connect([](int i) { return i; });
+    b->connect([&c](int i) { c.reset(); return i * 10; });
+    c->connect([&calls](int i) { ++calls; return i * 100; });
+
+    EXPECT_EQ(a(1), 11);
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(a(1), 11);
+
+    a.connect([&b](int) { b.reset(); return 0; });
+    EXPECT_EQ(a(1), 1);
+    EXPECT_EQ(a(2), 2);
+}
+
+TEST(signal, FilteredSlots)
+{
+    using signal = sig::signal<int(int, const std::string&), sig::sum_value<int>>;
+    signal s;
+
+    int calls = 0;
+    s.connect(sig::filter([](int i, const std::string&) { return i % 2 == 0; }),
+        [&calls](int i, const std::string&) { ++calls; return i; });
+    auto c = s.connect(sig::filter([](int, const std::string& str) { return str == "odd"; }),
+        [&calls](int i, const std::string&) { ++calls; return i * 10; });
+    s.connect([](int, const std::string&) { return 1; });
+
+    // Rejected slots return a disengaged result and are not invoked.
+    EXPECT_EQ(s(2, "even"), 3);
+    EXPECT_EQ(calls, 1);
+
+    EXPECT_EQ(s(3, "odd"), 31);
+    EXPECT_EQ(calls, 2);
+
+    EXPECT_EQ(s(4, "odd"), 45);
+    EXPECT_EQ(calls, 4);
+
+    // Filtered slots can be blocked.
+    c.block();
+    EXPECT_EQ(s(4, "odd"), 5);
+}
+
+TEST(signal, FilteredSlotsReference)
+{
+    // The predicate receives the same argument as the slot.
+    sig::signal<void(int&)> s;
+    s.connect(sig::filter([](int& i) { return i < 10; }), [](int& i) { i += 10; });
+    s.connect(sig::filter([](int& i) { return i < 10; }), [](int& i) { i += 100; });
+
+    int i = 0;
+    s(i);
+    EXPECT_EQ(i, 10);
+}
+
+TEST(signal, BoundFunction)
+{
+    using signal = sig::signal<void(int&)>;
+    signal s;
+
+    auto c = s.connect<decltype(&increment_counter), &increment_counter>();
+    s.connect<decltype(&increment_counter), &increment_counter>(sig::at_front);
+
+    int counter = 0;
+    s(counter);
+    EXPECT_EQ(counter, 2);
+
+    c.disconnect();
+    s(counter);
+    EXPECT_EQ(counter, 3);
+
+    // A bound slot is not equal to a slot that stores the same function.
+    s.connect(&increment_counter);
+    EXPECT_EQ(s.disconnect<decltype(&increment_counter)>(&increment_counter), 1u);
+    EXPECT_EQ((s.disconnect<decltype(&increment_counter), &increment_counter>()), 1u);
+    EXPECT_EQ(s.num_slots(), 0u);
+}
+
+TEST(signal, BoundMemberFunction)
+{
+    using signal = sig::signal<int(int, int)>;
+    signal s;
+
+    Base b1(1, 2);
+    Base b2(3, 4);
+    auto c1 = s.connect<decltype(&Base::multiply), &Base::multiply>(&b1);
+    s.connect<decltype(&Base::multiply), &Base::multiply>(&b2);
+
+    EXPECT_EQ(s(2, 3), 6);
+    EXPECT_EQ(s.num_slots(), 2u);
+
+    // Only the slot that is bound to the same object is disconnected.
+    Base* p = &b1;
+    EXPECT_EQ((s.disconnect<decltype(&Base::multiply), &Base::multiply>(p)), 1u);
+    EXPECT_FALSE(c1.connected());
+    EXPECT_EQ(s.num_slots(), 1u);
+    EXPECT_EQ((s.disconnect<decltype(&Base::multiply), &Base::multiply>(&b1)), 0u);
+}
+
+TEST(signal, BoundMemberFunctionTracked)
+{
+    using signal = sig::signal<int(int, int)>;
+    signal s;
+
+    auto b1 = std::make_shared<Base>(1, 2);
+    auto b2 = std::make_shared<Base>(3, 4);
+    s.connect<decltype(&Base::multiply), &Base::multiply>(b1);
+    s.connect<decltype(&Base::multiply), &Base::multiply>(b2);
+
+    // Tracked slots are compared by the object they track.
+    EXPECT_EQ((s.disconnect<decltype(&Base::multiply), &Base::multiply>(b2)), 1u);
+    EXPECT_EQ(s(2, 3), 6);
+
+    // The slot does not keep the object alive.
+    std::weak_ptr<Base> w = b1;
+    b1.reset();
+    EXPECT_TRUE(w.expired());
+    EXPECT_FALSE(s(2, 3));
+    EXPECT_EQ(s.num_slots(), 0u);
+}
+
+#if SIG_CPP17
+TEST(signal, BoundAuto)
+{
+    sig::signal<void(int&)> s1;
+    s1.connect<&increment_counter>();
+
+    int counter = 0;
+    s1(counter);
+    EXPECT_EQ(counter, 1);
+    EXPECT_EQ(s1.disconnect<&increment_counter>(), 1u);
+
+    sig::signal<int(int, int)> s2;
+    Base b(1, 2);
+    s2.connect<&Base::multiply>(&b);
+    EXPECT_EQ(s2(4, 5), 20);
+    EXPECT_EQ(s2.disconnect<&Base::multiply>(&b), 1u);
+    EXPECT_EQ(s2.num_slots(), 0u);
+}
+#endif
+
+TEST(signal, SlotRef)
+{
+    // A callable object that can't be copied.
+    struct Accumulator
+    {
+        Accumulator() = default;
+        Accumulator(const Accumulator&) = delete;
+        Accumulator& operator=(const Accumulator&) = delete;
+
+        void operator()(int i)
+        {
+            total += i;
+        }
+
+        int total = 0;
+    };
+
+    using signal = sig::signal<void(int)>;
+    signal s;
+
+    Accumulator a1;
+    Accumulator a2;
+    auto r = sig::ref(a1);
+    s.connect(r);
+    s.connect(sig::ref(a2), sig::at_front);
+
+    s(1);
+    EXPECT_EQ(a1.total, 1);
+    EXPECT_EQ(a2.total, 1);
+
+    // Copying a slot doesn't copy the callable object.
+    sig::slot<void(int)> slot(sig::ref(a1));
+    signal other;
+    other.connect(slot);
+    other.connect(slot);
+    other(1);
+    EXPECT_EQ(a1.total, 3);
+    EXPECT_EQ(a2.total, 1);
+
+    // References are compared by the address of the object.
+    EXPECT_EQ(s.disconnect(sig::ref(a1)), 1u);
+    EXPECT_EQ(s.disconnect(sig::ref(a1)), 0u);
+    s(4);
+    EXPECT_EQ(a1.total, 3);
+    EXPECT_EQ(a2.total, 5);
+    EXPECT_EQ(s.num_slots(), 1u);
+}
+
+TEST(signal, MoveOnlySlots)
+{
+    using signal = sig::signal<int(int)>;
+    signal s;
+
+    // Function objects that can only be moved don't need to be wrapped
+    // in a shared pointer.
+    std::unique_ptr<int> offset(new int(10));
+    s.connect([offset = std::move(offset)](int i) { return i + *offset; });
+    EXPECT_EQ(s(1), 11);
+
+    std::unique_ptr<int> factor(new int(2));
+    auto c = s.connect(sig::filter([](int i) { return i > 0; }), [factor = std::move(factor)](int i) { return i * *factor; });
+    EXPECT_EQ(s(3), 6);
+    EXPECT_EQ(s(-3), -3 + 10);
+    c.disconnect();
+
+    std::unique_ptr<int> count(new int(0));
+    s.connect_extended([count = std::move(count)](sig::connection_handle& h, int i) { ++*count; h.disconnect(); return i; });
+    EXPECT_EQ(s(5), 5);
+    EXPECT_EQ(s.num_slots(), 1u);
+
+    // Copying a slot requires a copy of the function object.
+    std::unique_ptr<int> value(new int(1));
+    sig::slot<int(int)> slot([value = std::move(value)](int i) { return i * *value; });
+    EXPECT_THROW(s.connect(slot), sig::not_copyable_exception);
+    EXPECT_EQ(s.num_slots(), 1u);
+
+    // The same holds for slots that track an object.
+    auto object = std::make_shared<int>(3);
+    std::unique_ptr<int> scale(new int(2));
+    sig::slot<int(int)> tracked([scale = std::move(scale)](const std::shared_ptr<int>& p, int i) { return i * *p * *scale; }, object);
+    EXPECT_THROW(s.connect(tracked), sig::not_copyable_exception);
+    EXPECT_EQ(s.num_slots(), 1u);
+
+    std::unique_ptr<int> divisor(new int(3));
+    s.connect([divisor = std::move(divisor)](const std::shared_ptr<int>& p, int i) { return i * *p / *divisor; }, object);
+    EXPECT_EQ(s(4), 4);
+    EXPECT_EQ(s.num_slots(), 2u);
+}
+
+TEST(signal, NothrowFlag)
+{
+    sig::signal<int(int)> s;
+    EXPECT_TRUE(s.nothrow());
+
+    s.connect([](int i) noexcept { return i; });
+    EXPECT_TRUE(s.nothrow());
+
+    auto c = s.connect([](int i) { return i * 2; });
+    EXPECT_FALSE(s.nothrow());
+
+    // The filter is invoked as well.
+    auto f = s.connect(sig::filter([](int i) { return i > 0; }), [](int i) noexcept { return i; });
+    c.disconnect();
+    EXPECT_FALSE(s.nothrow());
+
+    f.disconnect();
+    EXPECT_TRUE(s.nothrow());
+
+    // Slots that are removed while the signal is invoked are counted as well.
+    s.connect_extended([](sig::connection_handle& h, int i) { h.disconnect(); return i; });
+    EXPECT_FALSE(s.nothrow());
+    s(1);
+    EXPECT_TRUE(s.nothrow());
+}
+
+TEST(signal, NothrowSignal)
+{
+    using signal = sig::nothrow_signal<int(int)>;
+    signal s;
+    static_assert(noexcept(s(1)), "A nothrow_signal must be invoked with noexcept");
+    static_assert(!noexcept(std::declval<sig::signal<int(int)>&>()(1)), "A signal may throw");
+
+    struct receiver
+    {
+        int on_signal(int i) noexcept { return i + 1; }
+    };
+
+    receiver r;
+    auto tracked = std::make_shared<receiver>();
+    s.connect([](int i) noexcept { return i; });
+    s.connect(&receiver::on_signal, &r);
+    s.connect(&receiver::on_signal, tracked);
+    s.connect(sig::filter([](int i) noexcept { return i > 0; }), [](int i) noexcept { return i * 2; });
+
+    EXPECT_TRUE(s.nothrow());
+    EXPECT_EQ(s(1), 2);
+    EXPECT_EQ(s(-1), 0);
+}
+
+TEST(signal, ChunkedSlots)
+{
+    // Store the slots in chunks of 4 slots.
+    using signal = sig::signal<void(std::vector<int>&), sig::optional_last_value<void>, sig::chunked_slots<4>>;
+
+    signal s;
+
+    auto push = [](int value)
+    {
+        return [value](std::vector<int>& v) { v.push_back(value); };
+    };
+
+    std::vector<sig::connection> connections;
+    for (int i = 0; i < 10; ++i)
+    {
+        connections.push_back(s.connect(push(i + 3)));
+    }
+    s.connect(1, push(2));
+    s.connect(push(1), sig::at_front);
+    s.connect(push(0), sig::at_front);
+    EXPECT_EQ(s.num_slots(), 13u);
+
+    std::vector<int> v;
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }));
+
+    // Disconnect slots while the signal is invoked.
+    s.connect([&](std::vector<int>&)
+    {
+        for (std::size_t i = 0; i < connections.size(); i += 2)
+        {
+            connections[i].disconnect();
+        }
+    }, sig::at_front);
+
+    v.clear();
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 0, 1, 2, 4, 6, 8, 10, 12 }));
+
+    EXPECT_EQ(s.disconnect(1), 1u);
+    EXPECT_EQ(s.num_slots(), 8u);
+}
+
+TEST(signal, TypeGroupedSlots)
+{
+    using signal = sig::signal<void(std::vector<int>&), sig::optional_last_value<void>, sig::type_grouped_slots<>>;
+    signal s;
+
+    auto one = [](std::vector<int>& v) { v.push_back(1); };
+    auto two = [](std::vector<int>& v) { v.push_back(2); };
+
+    // Slots of the same type are stored next to each other.
+    s.connect(one);
+    auto c = s.connect(two);
+    s.connect(one);
+    s.connect(two);
+    s.connect(one);
+
+    // Groups are still invoked in order.
+    s.connect(1, two);
+    s.connect(1, one);
+    s.connect(1, two);
+
+    std::vector<int> v;
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 2, 2, 1, 1, 1, 1, 2, 2 }));
+
+    c.disconnect();
+    s.connect(two, sig::at_front);
+    s.connect(one, sig::at_front);
+    s.connect(two, sig::at_front);
+
+    v.clear();
+    s(v);
+    EXPECT_EQ(v, std::vector<int>({ 1, 2, 2, 2, 2, 1, 1, 1, 1, 2 }));
+}
@@ -0,0 +1,280 @@
+/**
+ * Tests the slot list types defined in signals.hpp.
+ */
+
+#include <signals.hpp>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using sig::detail::slot_list;
+using sig::detail::chunked_slot_list;
+
+TEST(slot_list, Inline)
+{
+    using list_type = slot_list<std::shared_ptr<int>, 4>;
+
+    list_type l;
+    EXPECT_TRUE(l.empty());
+    EXPECT_TRUE(l.is_inline());
+
+    for (int i = 0; i < 4; ++i)
+    {
+        l.push_back(std::make_shared<int>(i));
+    }
+
+    // All elements fit in the inline storage.
+    EXPECT_TRUE(l.is_inline());
+    EXPECT_EQ(l.size(), 4u);
+
+    int i = 0;
+    for (const auto& p : l)
+    {
+        EXPECT_EQ(*p, i++);
+    }
+
+    // Copies of inline lists are independent.
+    list_type copy(l);
+    l.pop_back();
+    EXPECT_EQ(l.size(), 3u);
+    EXPECT_EQ(copy.size(), 4u);
+    EXPECT_EQ(*copy[3], 3);
+}
+
+TEST(slot_list, Spill)
+{
+    using list_type = slot_list<std::shared_ptr<int>, 2>;
+
+    list_type l;
+    for (int i = 0; i < 5; ++i)
+    {
+        l.push_back(std::make_shared<int>(i));
+    }
+
+    // The list no longer fits in the inline storage.
+    EXPECT_FALSE(l.is_inline());
+    EXPECT_EQ(l.size(), 5u);
+
+    // Copies of heap lists share the same storage until modified.
+    const list_type snapshot(l);
+    EXPECT_EQ(snapshot.begin(), static_cast<const list_type&>(l).begin());
+
+    l[0] = std::make_shared<int>(42);
+    EXPECT_NE(snapshot.begin(), static_cast<const list_type&>(l).begin());
+    EXPECT_EQ(*snapshot[0], 0);
+    EXPECT_EQ(*l[0], 42);
+
+    // Shrinking the list moves the elements back to the inline storage.
+    while (l.size() > 1)
+    {
+        l.pop_back();
+    }
+    EXPECT_TRUE(l.is_inline());
+    EXPECT_EQ(*l[0], 42);
+    EXPECT_EQ(snapshot.size(), 5u);
+    EXPECT_EQ(*snapshot[4], 4);
+}
+
+TEST(slot_list, Move)
+{
+    using list_type = slot_list<std::shared_ptr<int>, 2>;
+
+    auto p = std::make_shared<int>(7);
+
+    list_type l1;
+    l1.push_back(std::shared_ptr<int>(p));
+
+    list_type l2(std::move(l1));
+    EXPECT_TRUE(l1.empty());
+    EXPECT_EQ(l2.size(), 1u);
+    EXPECT_EQ(p.use_count(), 2);
+
+    l2.clear();
+    EXPECT_TRUE(l2.empty());
+    EXPECT_EQ(p.use_count(), 1);
+}
+
+TEST(slot_list, EraseIf)
+{
+    using list_type = slot_list<std::shared_ptr<int>, 2>;
+
+    list_type l;
+    for (int i = 0; i < 8; ++i)
+    {
+        l.push_back(std::make_shared<int>(i));
+    }
+    const list_type snapshot(l);
+
+    // Nothing is copied if no element is removed.
+    EXPECT_EQ(l.erase_if([](const std::shared_ptr<int>& p, std::size_t) { return *p > 10; }), 0u);
+    EXPECT_EQ(snapshot.begin(), static_cast<const list_type&>(l).begin());
+
+    std::size_t calls = 0;
+    EXPECT_EQ(l.erase_if([&calls](const std::shared_ptr<int>& p, std::size_t i)
+    {
+        EXPECT_EQ(i, calls++);
+        return *p % 3 != 0;
+    }), 5u);
+    EXPECT_EQ(calls, 8u);
+
+    EXPECT_EQ(l.size(), 3u);
+    EXPECT_EQ(*l[0], 0);
+    EXPECT_EQ(*l[1], 3);
+    EXPECT_EQ(*l[2], 6);
+    EXPECT_EQ(snapshot.size(), 8u);
+}
+
+TEST(chunked_slot_list, Append)
+{
+    using list_type = chunked_slot_list<std::shared_ptr<int>, 4>;
+
+    list_type l;
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(l.begin(), l.end());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        l.push_back(std::make_shared<int>(i));
+    }
+
+    // Appending to a full chunk starts a new chunk.
+    EXPECT_EQ(l.size(), 10u);
+    EXPECT_EQ(l.num_chunks(), 3u);
+
+    int i = 0;
+    for (const auto& p : l)
+    {
+        EXPECT_EQ(*p, i++);
+    }
+    EXPECT_EQ(i, 10);
+
+    for (std::size_t j = 0; j < l.size(); ++j)
+    {
+        EXPECT_EQ(*static_cast<const list_type&>(l)[j], static_cast<int>(j));
+    }
+}
+
+TEST(chunked_slot_list, InsertErase)
+{
+    using list_type = chunked_slot_list<std::shared_ptr<int>, 4>;
+
+    list_type l;
+    for (int i = 0; i < 8; ++i)
+    {
+        l.push_back(std::make_shared<int>(i));
+    }
+    EXPECT_EQ(l.num_chunks(), 2u);
+
+    // Inserting into a full chunk splits it.
+    l.insert(1, std::make_shared<int>(42));
+    EXPECT_EQ(l.num_chunks(), 3u);
+
+    const int expected[] = { 0, 42, 1, 2, 3, 4, 5, 6, 7 };
+    std::size_t i = 0;
+    for (const auto& p : l)
+    {
+        EXPECT_EQ(*p, expected[i++]);
+    }
+    EXPECT_EQ(i, 9u);
+
+    // Erasing elements removes empty chunks and merges small chunks.
+    l.erase(1);
+    l.erase(0);
+    l.erase(0);
+    EXPECT_EQ(l.size(), 6u);
+    EXPECT_EQ(*static_cast<const list_type&>(l)[0], 2);
+    EXPECT_EQ(*static_cast<const list_type&>(l)[5], 7);
+
+    while (!l.empty())
+    {
+        l.pop_back();
+    }
+    EXPECT_EQ(l.num_chunks(), 0u);
+    EXPECT_EQ(l.begin(), l.end());
+}
+
+TEST(chunked_slot_list, Snapshot)
+{
+    using list_type = chunked_slot_list<std::shared_ptr<int>, 4>;
+
+    list_type l;
+    for (int i = 0; i < 12; ++i)
+    {
+        l.push_back(std::make_shared<int>(i));
+    }
+
+    const list_type snapshot(l);
+    const auto& first = *snapshot.begin();
+
+    // Modifying the list only copies the modified chunk.
+    l[10] = std::make_shared<int>(42);
+    EXPECT_EQ(*snapshot[10], 10);
+    EXPECT_EQ(*l[10], 42);
+    EXPECT_EQ(&*static_cast<const list_type&>(l).begin(), &first);
+
+    l.erase(0);
+    l.push_back(std::make_shared<int>(12));
+    EXPECT_EQ(snapshot.size(), 12u);
+    EXPECT_EQ(l.size(), 12u);
+
+    int i = 0;
+    for (const auto& p : snapshot)
+    {
+        EXPECT_EQ(*p, i++);
+    }
+    EXPECT_EQ(*static_cast<const list_type&>(l)[0], 1);
+    EXPECT_EQ(*static_cast<const list_type&>(l)[11], 12);
+
+    l.clear();
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(snapshot.size(), 12u);
+}
+
+TEST(chunked_slot_list, EraseIf)
+{
+    using list_type = chunked_slot_list<std::shared_ptr<int>, 4>;
+
+    list_type l;
+    for (int i = 0; i < 16; ++i)
+    {
+        l.push_back(std::make_shared<int>(i));
+    }
+    EXPECT_EQ(l.num_chunks(), 4u);
+
+    const list_type snapshot(l);
+    const auto& first = *snapshot.begin();
+    const auto& last = snapshot[15];
+
+    std::size_t calls = 0;
+    EXPECT_EQ(l.erase_if([&calls](const std::shared_ptr<int>& p, std::size_t i)
+    {
+        EXPECT_EQ(i, calls++);
+        return *p == 5 || *p == 6;
+    }), 2u);
+    EXPECT_EQ(calls, 16u);
+
+    // Only the chunk of the removed elements is copied.
+    EXPECT_EQ(&*static_cast<const list_type&>(l).begin(), &first);
+    EXPECT_EQ(&static_cast<const list_type&>(l)[13], &last);
+    EXPECT_EQ(l.num_chunks(), 4u);
+    EXPECT_EQ(l.size(), 14u);
+    EXPECT_EQ(snapshot.size(), 16u);
+
+    const int expected[] = { 0, 1, 2, 3, 4, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    std::size_t i = 0;
+    for (const auto& p : l)
+    {
+        EXPECT_EQ(*p, expected[i++]);
+    }
+    EXPECT_EQ(i, 14u);
+
+    // Empty chunks are removed and small neighboring chunks are merged.
+    EXPECT_EQ(l.erase_if([](const std::shared_ptr<int>& p, std::size_t) { return *p < 11 || *p > 12; }), 12u);
+    EXPECT_EQ(l.num_chunks(), 1u);
+    EXPECT_EQ(*static_cast<const list_type&>(l)[0], 11);
+    EXPECT_EQ(*static_cast<const list_type&>(l)[1], 12);
+
+    EXPECT_EQ(l.erase_if([](const std::shared_ptr<int>&, std::size_t) { return true; }), 2u);
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(l.num_chunks(), 0u);
+}
@@ -0,0 +1,78 @@
+/**
+ * Tests the latency histograms that are recorded when SIG_SLOT_STATS is enabled.
+ * This file is compiled into a separate test executable with SIG_SLOT_STATS=1.
+ */
+
+#include <signals.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#if !SIG_SLOT_STATS
+#error "slot_stats_tests must be compiled with SIG_SLOT_STATS=1"
+#endif
+
+TEST(slot_stats, Buckets)
+{
+    using h = sig::latency_histogram;
+
+    // Small values have their own bucket.
+    for (std::uint64_t ns = 0; ns < 8; ++ns)
+    {
+        EXPECT_EQ(h::bucket(ns), ns);
+        EXPECT_EQ(h::upper_bound(h::bucket(ns)), ns);
+    }
+
+    // Every value is less than or equal to the upper bound of its bucket
+    // and larger than the upper bound of the previous bucket.
+    for (std::uint64_t ns = 8; ns < (1u << 20); ns += 7)
+    {
+        const auto b = h::bucket(ns);
+        EXPECT_LE(ns, h::upper_bound(b));
+        EXPECT_GT(ns, h::upper_bound(b - 1));
+    }
+
+    // Large values are clamped to the last bucket.
+    EXPECT_EQ(h::bucket(~std::uint64_t(0)), h::num_buckets - 1);
+}
+
+TEST(slot_stats, Record)
+{
+    using signal = sig::signal<void(int)>;
+    signal s;
+
+    auto fast = s.connect([](int) {});
+    auto slow = s.connect([](int ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    });
+
+    EXPECT_EQ(fast.stats().count(), 0u);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        s(i == 9 ? 20 : 1);
+    }
+
+    const auto stats = slow.stats();
+    EXPECT_EQ(stats.count(), 10u);
+    EXPECT_EQ(fast.stats().count(), 10u);
+
+    // The slowest invocation slept for 20 ms.
+    EXPECT_GE(stats.max_ns(), 20000000u);
+    EXPECT_GE(stats.percentile(100), stats.percentile(50));
+    EXPECT_GE(stats.percentile(50), 1000000u);
+    EXPECT_LT(stats.percentile(50), 20000000u);
+    EXPECT_GT(stats.mean_ns(), 1000000.0);
+    EXPECT_LT(fast.stats().max_ns(), stats.max_ns());
+
+    // Blocked slots are not recorded.
+    slow.block();
+    s(1);
+    EXPECT_EQ(slow.stats().count(), 10u);
+
+    // Disconnected slots return an empty histogram.
+    slow.disconnect();
+    EXPECT_EQ(slow.stats().count(), 0u);
+}
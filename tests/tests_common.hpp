@@ -26,8 +26,8 @@ public:
     }
 };
 
-auto lambda = [](int i, int j) { return i + j; };
-auto void_lambda = []() {};
+inline auto lambda = [](int i, int j) { return i + j; };
+inline auto void_lambda = []() {};
 
 struct Functor
 {
@@ -0,0 +1,208 @@
+/**
+ * Tests the trace events that are recorded when SIG_TRACE is enabled.
+ * This file is compiled into a separate test executable with SIG_TRACE=1.
+ * It also replaces the global allocation functions so that allocations can
+ * be made to fail.
+ */
+
+#include <signals.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if !SIG_TRACE
+#error "trace_tests must be compiled with SIG_TRACE=1"
+#endif
+
+namespace
+{
+    // Makes the allocations of the current thread throw std::bad_alloc.
+    thread_local bool t_FailAllocations = false;
+
+    std::size_t count(const std::string& str, const std::string& pattern)
+    {
+        std::size_t n = 0;
+        for (auto pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+        {
+            ++n;
+        }
+        return n;
+    }
+
+    std::string trace_json()
+    {
+        std::ostringstream os;
+        sig::trace::write_json(os);
+        return os.str();
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (!t_FailAllocations)
+    {
+        if (auto p = std::malloc(size ? size : 1))
+            return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+TEST(trace, Disabled)
+{
+    sig::trace::stop();
+    sig::trace::clear();
+
+    sig::signal<void()> s;
+    s.connect([] {});
+    s();
+
+    // Nothing is recorded while tracing is stopped.
+    EXPECT_FALSE(sig::trace::enabled());
+    EXPECT_EQ(count(trace_json(), "\"ph\""), 0u);
+}
+
+TEST(trace, SignalAndSlots)
+{
+    sig::trace::clear();
+    sig::trace::start();
+
+    sig::signal<int(int)> s;
+    s.set_name("value_changed");
+    EXPECT_STREQ(s.name(), "value_changed");
+
+    s.connect([](int i) { return i; });
+    s.connect([](int i) { return i * 2; });
+    s(3);
+
+    sig::trace::stop();
+
+    const auto json = trace_json();
+
+    // One begin and one end event for the signal and each slot.
+    EXPECT_EQ(count(json, "\"name\":\"value_changed\",\"cat\":\"signal\""), 2u);
+    EXPECT_EQ(count(json, "\"cat\":\"slot\""), 4u);
+    EXPECT_EQ(count(json, "\"ph\":\"B\""), 3u);
+    EXPECT_EQ(count(json, "\"ph\":\"E\""), 3u);
+
+    // The slots are nested in the signal.
+    EXPECT_LT(json.find("value_changed"), json.find("\"cat\":\"slot\""));
+    EXPECT_LT(json.rfind("\"cat\":\"slot\""), json.rfind("value_changed"));
+
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+}
+
+TEST(trace, UnnamedSignal)
+{
+    sig::trace::clear();
+    sig::trace::start();
+
+    sig::signal<void()> s;
+    EXPECT_EQ(s.name(), nullptr);
+    s();
+
+    sig::trace::stop();
+
+    EXPECT_EQ(count(trace_json(), "\"name\":\"signal\""), 2u);
+}
+
+TEST(trace, EscapedName)
+{
+    sig::trace::clear();
+    sig::trace::start();
+
+    sig::signal<void()> s;
+    s.set_name("say \"hi\"");
+    s();
+
+    sig::trace::stop();
+
+    EXPECT_EQ(count(trace_json(), "\"name\":\"say \\\"hi\\\"\""), 2u);
+}
+
+TEST(trace, Threads)
+{
+    sig::trace::clear();
+    sig::trace::start();
+
+    sig::signal<void()> s;
+    s.set_name("tick");
+    s.connect([] {});
+
+    std::thread t1([&] { for (int i = 0; i < 100; ++i) s(); });
+    std::thread t2([&] { for (int i = 0; i < 100; ++i) s(); });
+    t1.join();
+    t2.join();
+
+    sig::trace::stop();
+
+    const auto json = trace_json();
+
+    // The events of threads that have exited are kept.
+    EXPECT_EQ(count(json, "\"name\":\"tick\""), 400u);
+    EXPECT_EQ(count(json, "\"cat\":\"slot\""), 400u);
+}
+
+TEST(trace, RingBuffer)
+{
+    sig::trace::clear();
+    sig::trace::start();
+
+    sig::signal<void()> s;
+
+    // Each invocation records two events, so the buffer wraps around.
+    const std::size_t invocations = sig::detail::trace_buffer::capacity;
+    for (std::size_t i = 0; i < invocations; ++i)
+    {
+        s();
+    }
+
+    sig::trace::stop();
+
+    // Only the newest events are kept.
+    EXPECT_EQ(count(trace_json(), "\"ph\""), std::size_t(sig::detail::trace_buffer::capacity));
+}
+
+TEST(trace, DroppedScopes)
+{
+    sig::trace::clear();
+    sig::trace::start();
+
+    sig::signal<void()> s;
+    s.set_name("tick");
+    s.connect([] {});
+
+    std::thread t([&]
+    {
+        // The trace buffer of the thread can't be allocated, so neither the
+        // signal nor the slot invocation is recorded.
+        t_FailAllocations = true;
+        s();
+        t_FailAllocations = false;
+
+        s();
+    });
+    t.join();
+
+    sig::trace::stop();
+
+    EXPECT_EQ(sig::trace::dropped(), 2u);
+    EXPECT_EQ(count(trace_json(), "\"name\":\"tick\""), 2u);
+
+    sig::trace::clear();
+    EXPECT_EQ(sig::trace::dropped(), 0u);
+}